@@ -8,6 +8,138 @@
 
 using namespace taco;
 
+// Strided-batched variants of the BLAS functions below, as provided by MKL.
+// Each performs a batch of independent problems, stored one after the other,
+// in a single call.  The batch is indexed by b.
+class SaxpyBatchStrided : public AbstractFunctionInterface{
+    public: 
+        SaxpyBatchStrided() : x(TensorObject(Type(taco::Float32, {Dimension(), Dimension()}), Format{Dense, Dense})),
+                              y(TensorObject(Type(taco::Float32, {Dimension(), Dimension()}), Format{Dense, Dense})),
+                              b(IndexVar()),
+                              i(IndexVar()) {};
+
+        taco::AcceleratorStmt getStmt() const override{ return x(b, i) = x(b, i) + y(b, i);}
+        std::vector<Argument> getArguments() const override {return 
+                                                {
+                                                    new DimArg(i), 
+                                                    new LiteralArg(Datatype(taco::UInt32), 1),
+                                                    new TensorObjectArg(y), 
+                                                    new LiteralArg(Datatype(taco::UInt32), 1),
+                                                    new DimArg(i), 
+                                                    new TensorObjectArg(x), 
+                                                    new LiteralArg(Datatype(taco::UInt32), 1),
+                                                    new DimArg(i), 
+                                                    new DimArg(b)
+                                                };}
+        std::string getReturnType() const override {return "void";}
+        std::string getFunctionName() const override{return "cblas_saxpy_batch_strided";}
+        bool isThreadSafe() const override {return true;}
+
+    private: 
+        TensorObject x;
+        TensorObject y;
+        IndexVar b;
+        IndexVar i;
+};
+
+class SgemvBatchStrided : public AbstractFunctionInterface{
+    public: 
+        SgemvBatchStrided() : x(TensorObject(Type(taco::Float32, {Dimension(), Dimension(), Dimension()}), Format{Dense, Dense, Dense})), 
+                              y(TensorObject(Type(taco::Float32, {Dimension(), Dimension()}), Format{Dense, Dense})),
+                              s(TensorObject(Type(taco::Float32, {Dimension(), Dimension()}), Format{Dense, Dense})),
+                              b(IndexVar()),
+                              i(IndexVar()),
+                              j(IndexVar()) {};
+        AcceleratorStmt getStmt() const override {return y(b, i) = x(b, i, j)*s(b, j) + y(b, i);}
+        std::vector<Argument> getArguments() const override {return 
+                                                {
+                                                    new StringLiteral("CblasRowMajor"), 
+                                                    new StringLiteral("CblasNoTrans"),
+                                                    new DimArg(i), 
+                                                    new DimArg(j), 
+                                                    new LiteralArg(Datatype(taco::UInt32), 1),
+                                                    new TensorObjectArg(x), 
+                                                    new DimArg(j),
+                                                    new DimProduct({i, j}),
+                                                    new TensorObjectArg(s), 
+                                                    new LiteralArg(Datatype(taco::UInt32), 1),
+                                                    new DimArg(j),
+                                                    new LiteralArg(Datatype(taco::UInt32), 1),
+                                                    new TensorObjectArg(y), 
+                                                    new LiteralArg(Datatype(taco::UInt32), 1),
+                                                    new DimArg(i),
+                                                    new DimArg(b)
+                                                };}
+        std::string getReturnType() const override {return "void";}
+        std::string getFunctionName() const override {return "cblas_sgemv_batch_strided";}
+        bool isThreadSafe() const override {return true;}
+
+    private: 
+        TensorObject x;
+        TensorObject y;
+        TensorObject s;
+        IndexVar b;
+        IndexVar i;
+        IndexVar j;
+};
+
+// Computes z(b, i, k) = x(b, i, j) * y(b, j, k), accumulating into z if
+// accumulate is set.
+class SgemmBatchStrided : public AbstractFunctionInterface{
+    public: 
+        SgemmBatchStrided(bool accumulate) : 
+                    x(TensorObject(Type(taco::Float32, {Dimension(), Dimension(), Dimension()}),  Format{Dense, Dense, Dense})),
+                    y(TensorObject(Type(taco::Float32, {Dimension(), Dimension(), Dimension()}),  Format{Dense, Dense, Dense})),
+                    z(TensorObject(Type(taco::Float32, {Dimension(), Dimension(), Dimension()}),  Format{Dense, Dense, Dense})),
+                    b(IndexVar()),
+                    i(IndexVar()),
+                    j(IndexVar()),
+                    k(IndexVar()),
+                    accumulate(accumulate) {}; 
+
+        AcceleratorStmt getStmt() const override {
+          if (accumulate) {
+            return z(b, i, k) = x(b, i, j) * y(b, j, k) + z(b, i, k);
+          }
+          return z(b, i, k) = x(b, i, j) * y(b, j, k);
+        } 
+        std::vector<Argument> getArguments() const override {
+                                                return 
+                                                {   new StringLiteral("CblasRowMajor"),
+                                                    new StringLiteral("CblasNoTrans"),
+                                                    new StringLiteral("CblasNoTrans"),
+                                                    new DimArg(i), 
+                                                    new DimArg(k), 
+                                                    new DimArg(j), 
+                                                    new LiteralArg(Datatype(taco::UInt32), 1),
+                                                    new TensorObjectArg(x), 
+                                                    new DimArg(j), 
+                                                    new DimProduct({i, j}),
+                                                    new TensorObjectArg(y), 
+                                                    new DimArg(k), 
+                                                    new DimProduct({j, k}),
+                                                    new LiteralArg(Datatype(taco::UInt32), accumulate ? 1 : 0),
+                                                    new TensorObjectArg(z), 
+                                                    new DimArg(k), 
+                                                    new DimProduct({i, k}),
+                                                    new DimArg(b)
+                                                }; }
+
+        std::string getReturnType() const override {return "void";}
+        std::string getFunctionName() const override {return "cblas_sgemm_batch_strided";}
+        bool isThreadSafe() const override {return true;}
+
+    private: 
+        TensorObject x;
+        TensorObject y;
+        TensorObject z;
+        IndexVar b;
+        IndexVar i;
+        IndexVar j;
+        IndexVar k;
+        bool accumulate;
+};
+
 // Inherit from AbstractFunctionInterface class to define an external interface.
 class Saxpy : public AbstractFunctionInterface{
     public: 
@@ -40,10 +172,17 @@ class Saxpy : public AbstractFunctionInterface{
         // Specify the name of the Saxpy function as a string.
         std::string getFunctionName() const override{return "cblas_saxpy";}
 
+        // Independent calls to cblas_saxpy may be made from several threads.
+        bool isThreadSafe() const override {return true;}
+
         // There are no additional constraints associated wth the Saxpy function,
         // therefore, the checker function simply returns true.
         bool checkerFunction(IndexStmt stmt) const override{return true;}
 
+        // Calls made for every row of a batch are coalesced into one call of
+        // the strided-batched variant.
+        FunctionInterface getBatchedInterface() const override {return new SaxpyBatchStrided();}
+
     private: 
         TensorObject x;
         TensorObject y;
@@ -71,6 +210,7 @@ class Sdot : public AbstractFunctionInterface{
                                                 };}
         std::string getReturnType() const override {return "float";}
         std::string getFunctionName() const override {return "cblas_sdot";}
+        bool isThreadSafe() const override {return true;}
 
     private: 
         TensorObject x;
@@ -104,6 +244,8 @@ class Sgemv : public AbstractFunctionInterface{
                                                 };}
         std::string getReturnType() const override {return "void";}
         std::string getFunctionName() const override {return "cblas_sgemv";}
+        bool isThreadSafe() const override {return true;}
+        FunctionInterface getBatchedInterface() const override {return new SgemvBatchStrided();}
 
     private: 
         TensorObject x;
@@ -144,6 +286,8 @@ class Sgemm : public AbstractFunctionInterface{
 
         std::string getReturnType() const override {return "void";}
         std::string getFunctionName() const override {return "cblas_sgemm";}
+        bool isThreadSafe() const override {return true;}
+        FunctionInterface getBatchedInterface() const override {return new SgemmBatchStrided(true);}
 
     private: 
         TensorObject x;
@@ -187,6 +331,8 @@ class MatrixMultiply : public AbstractFunctionInterface{
 
         std::string getReturnType() const override {return "void";}
         std::string getFunctionName() const override {return "cblas_sgemm";}
+        bool isThreadSafe() const override {return true;}
+        FunctionInterface getBatchedInterface() const override {return new SgemmBatchStrided(false);}
         
         
     private: 
@@ -229,6 +375,7 @@ class BlasSymmLeft : public AbstractFunctionInterface{
 
         std::string getReturnType() const override {return "void";}
         std::string getFunctionName() const override {return "cblas_ssymm";}
+        bool isThreadSafe() const override {return true;}
         
         
     private: 
@@ -266,6 +413,7 @@ class CblasGemv : public AbstractFunctionInterface{
                                                 };}
         std::string getReturnType() const override {return "void";}
         std::string getFunctionName() const override {return "cblas_sgemv";}
+        bool isThreadSafe() const override {return true;}
 
     private: 
         TensorObject x;
@@ -300,6 +448,7 @@ class CblasSymmetricGemV : public AbstractFunctionInterface{
                                                 };}
         std::string getReturnType() const override {return "void";}
         std::string getFunctionName() const override {return "cblas_ssymv";}
+        bool isThreadSafe() const override {return true;}
 
     private: 
         TensorObject x;
@@ -23,6 +23,7 @@ class GSLVecAdd : public AbstractFunctionInterface{
                                                 };}
         std::string getReturnType() const override {return "void";}
         std::string getFunctionName() const override{return "gsl_vector_float_add";}
+        bool isThreadSafe() const override {return true;}
         bool checkerFunction(IndexStmt stmt) const override{return true;}
 
         std::vector<Argument>  callBefore() const override {
@@ -65,6 +66,7 @@ class GSLDot : public AbstractFunctionInterface{
                                                 };}
         std::string getReturnType() const override {return "void";}
         std::string getFunctionName() const override{return "gsl_blas_sdot";}
+        bool isThreadSafe() const override {return true;}
         bool checkerFunction(IndexStmt stmt) const override{return true;}
 
         std::vector<Argument>  callBefore() const override {
@@ -111,6 +113,7 @@ class GSLSgemv : public AbstractFunctionInterface{
                                                 };}
         std::string getReturnType() const override {return "void";}
         std::string getFunctionName() const override{return "gsl_blas_sgemv";}
+        bool isThreadSafe() const override {return true;}
         bool checkerFunction(IndexStmt stmt) const override{return true;}
 
         std::vector<Argument>  callBefore() const override {
@@ -163,6 +166,7 @@ class GSLGemv : public AbstractFunctionInterface{
                                                 };}
         std::string getReturnType() const override {return "void";}
         std::string getFunctionName() const override{return "gsl_blas_sgemv";}
+        bool isThreadSafe() const override {return true;}
         bool checkerFunction(IndexStmt stmt) const override{return true;}
 
         std::vector<Argument>  callBefore() const override {
@@ -218,6 +222,7 @@ class GSLMM : public AbstractFunctionInterface{
                                                 };}
         std::string getReturnType() const override {return "void";}
         std::string getFunctionName() const override{return "gsl_blas_sgemm";}
+        bool isThreadSafe() const override {return true;}
         bool checkerFunction(IndexStmt stmt) const override{return true;}
 
         std::vector<Argument>  callBefore() const override {
@@ -271,6 +276,7 @@ class GSLSymmetricGemv : public AbstractFunctionInterface{
                                                 };}
         std::string getReturnType() const override {return "void";}
         std::string getFunctionName() const override{return "gsl_blas_ssymv";}
+        bool isThreadSafe() const override {return true;}
         bool checkerFunction(IndexStmt stmt) const override{return true;}
 
         std::vector<Argument>  callBefore() const override {
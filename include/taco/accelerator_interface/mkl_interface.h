@@ -26,6 +26,7 @@ class MklSgemv : public AbstractFunctionInterface{
                                                 };}
         std::string getReturnType() const override {return "void";}
         std::string getFunctionName() const override {return "sgemv_mkl_internal";}
+        bool isThreadSafe() const override {return true;}
     private: 
         TensorObject x;
         TensorObject y;
@@ -56,6 +57,7 @@ class SparseMklSgemv : public AbstractFunctionInterface{
                                                 };}
         std::string getReturnType() const override {return "void";}
         std::string getFunctionName() const override {return "mkl_scsrgemv_internal";}
+        bool isThreadSafe() const override {return true;}
     private: 
         TensorObject x;
         TensorObject y;
@@ -91,6 +93,7 @@ public:
 
         std::string getReturnType() const override {return "void";}
         std::string getFunctionName() const override {return "mkl_sparse_s_mm_internal";}
+        bool isThreadSafe() const override {return true;}
     private: 
         TensorObject x;
         TensorObject y;
@@ -117,6 +120,7 @@ class MklSymmgemv : public AbstractFunctionInterface{
                                                 };}
         std::string getReturnType() const override {return "void";}
         std::string getFunctionName() const override {return "ssymv_mkl_internal";}
+        bool isThreadSafe() const override {return true;}
     private: 
         TensorObject x;
         TensorObject y;
@@ -149,6 +153,7 @@ public:
 
         std::string getReturnType() const override {return "void";}
         std::string getFunctionName() const override {return "sgemm_mkl_internal";}
+        bool isThreadSafe() const override {return true;}
     private: 
         TensorObject x;
         TensorObject y;
@@ -177,6 +182,7 @@ class MklDot : public AbstractFunctionInterface{
                                                 };}
         std::string getReturnType() const override {return "float";}
         std::string getFunctionName() const override {return "sdot_mkl_internal";}
+        bool isThreadSafe() const override {return true;}
 
     private: 
         TensorObject x;
@@ -203,6 +209,7 @@ class MklAdd : public AbstractFunctionInterface{
                                                 };}
         std::string getReturnType() const override {return "void";}
         std::string getFunctionName() const override {return "mkl_sparse_s_add_internal";}
+        bool isThreadSafe() const override {return true;}
 
     private: 
         TensorObject x;
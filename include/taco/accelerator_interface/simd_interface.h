@@ -0,0 +1,84 @@
+#ifndef SIMD_INTERFACE_H
+#define SIMD_INTERFACE_H
+
+#include "taco/index_notation/index_notation.h"
+#include "taco/type.h"
+#include "taco/accelerator_notation/accel_interface.h"
+#include "taco/accelerator_notation/accelerator_notation.h"
+
+using namespace taco;
+
+// Instruction sets that the SIMD kernels of the generated code have variants
+// for.  Every variant is compiled into the generated module, and the most
+// capable one that the processor supports is picked when the module is loaded.
+enum class SIMDInstructionSet {SSE, AVX2, AVX512};
+
+// Returns the instruction set whose variants the generated code runs on this
+// processor.
+inline SIMDInstructionSet getHostSIMDInstructionSet() {
+#if defined(__GNUC__) && defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SIMDInstructionSet::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SIMDInstructionSet::AVX2;
+    }
+#endif
+    return SIMDInstructionSet::SSE;
+}
+
+// Returns the number of floats in a vector register of the instruction set.
+inline int getSIMDVectorWidth(SIMDInstructionSet instructionSet) {
+    switch (instructionSet) {
+        case SIMDInstructionSet::AVX512:
+            return 16;
+        case SIMDInstructionSet::AVX2:
+            return 8;
+        case SIMDInstructionSet::SSE:
+            return 4;
+    }
+    return 4;
+}
+
+// Adds two vectors with the variant of taco_simdAdd that the processor
+// supports.  The interface is a family with one member per instruction set,
+// whose constraints make the accelerator search pick lengths, and tile
+// sizes, that are multiples of the vector width of that instruction set.  By
+// default the member is the one for the instruction set the generated code
+// runs on this processor.  Any length is computed correctly, since elements
+// past the last full vector are added one at a time.
+class SIMDAdd : public AbstractFunctionInterface{
+    public:
+        SIMDAdd(SIMDInstructionSet instructionSet = getHostSIMDInstructionSet())
+                  : width(getSIMDVectorWidth(instructionSet)),
+                    x(TensorObject(Type(taco::Float32, {Dimension()}), dense)),
+                    y(TensorObject(Type(taco::Float32, {Dimension()}), dense)),
+                    z(TensorObject(Type(taco::Float32, {Dimension()}), dense)),
+                    i(IndexVar()) {};
+
+        AcceleratorStmt getStmt() const override {return z(i) = x(i) + y(i);}
+        std::vector<Argument> getArguments() const override {
+                                                return
+                                                {   new DimArg(i),
+                                                    new TensorObjectArg(x),
+                                                    new TensorObjectArg(y),
+                                                    new TensorObjectArg(z)
+                                                }; }
+
+        std::string getReturnType() const override {return "void";}
+        std::string getFunctionName() const override {return "taco_simdAdd";}
+        bool isThreadSafe() const override {return true;}
+        DynamicStmt getConstraints() const override {return DynamicMod(DynamicExpr(i), width) == 0;}
+
+        int getVectorWidth() const {return width;}
+
+    private:
+        int width;
+        TensorObject x;
+        TensorObject y;
+        TensorObject z;
+        IndexVar i;
+};
+
+#endif
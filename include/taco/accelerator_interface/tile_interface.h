@@ -26,6 +26,7 @@ class TileSaxpy : public AbstractFunctionInterface{
                                                 };}
         std::string getReturnType() const override {return "void";}
         std::string getFunctionName() const override{return "cblas_saxpy";}
+        bool isThreadSafe() const override {return true;}
         bool checkerFunction(IndexStmt stmt) const override{return true;}
 
     private: 
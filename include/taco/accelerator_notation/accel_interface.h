@@ -19,7 +19,7 @@ template <typename CType>
 class Tensor;
 
 // Different types of internal arguments provided through Mosaic.
-enum ArgType {DIM, TENSORVAR, TENSOR_OBJECT, TENSOR, EXPR, LITERAL, USER_DEFINED, DECLVAR, UNKNOWN, DIMLIST, DATA_ARRAY, STRING, DECLVAR_ADDR, TENSOR_ADDR, TENSOR_NAME, CAST};
+enum ArgType {DIM, TENSORVAR, TENSOR_OBJECT, TENSOR, EXPR, LITERAL, USER_DEFINED, DECLVAR, UNKNOWN, DIMLIST, DATA_ARRAY, STRING, DECLVAR_ADDR, TENSOR_ADDR, TENSOR_NAME, CAST, DIM_PRODUCT};
 
 
 // TransferTypeArgs is the parent class that all internal arguments inherit from.
@@ -138,6 +138,17 @@ struct DimArg : public TransferTypeArgs{
     IndexVar indexVar;
 };
 
+// Internal argument used to pass the product of the sizes of the dimensions
+// that index variables are used to index into, such as the stride between
+// consecutive matrices of a batch.
+struct DimProduct : public TransferTypeArgs{
+    explicit DimProduct(const std::vector<IndexVar>& indexVars): TransferTypeArgs(DIM_PRODUCT), indexVars(indexVars) {}
+
+    std::ostream& print(std::ostream& os) const override;
+
+    std::vector<IndexVar> indexVars;
+};
+
 // Internal argument used to pass the name of a user-declared object to an
 // external function.
 struct  DeclVar {
@@ -472,8 +483,8 @@ class ConcreteAccelerateCodeGenerator {
     ConcreteAccelerateCodeGenerator() = default;
 
     ConcreteAccelerateCodeGenerator(const std::string& functionName, const std::string& returnType, const taco::IndexExpr& lhs, const taco::IndexExpr& rhs, const std::vector<Argument>& args, 
-                                    const std::vector<Argument>& callBefore, const std::vector<Argument>& callAfter)
-                                    : functionName(functionName), returnType(returnType), lhs(lhs), rhs(rhs), args(args), callBefore(callBefore), callAfter(callAfter) {}
+                                    const std::vector<Argument>& callBefore, const std::vector<Argument>& callAfter, bool threadSafe = false)
+                                    : functionName(functionName), returnType(returnType), lhs(lhs), rhs(rhs), args(args), callBefore(callBefore), callAfter(callAfter), threadSafe(threadSafe) {}
 
     ConcreteAccelerateCodeGenerator(const std::string& functionName, const std::string& returnType, taco::IndexExpr lhs, taco::IndexExpr rhs, const std::vector<Argument>& callBefore,
                                     const std::vector<Argument>& callAfter)
@@ -487,19 +498,20 @@ class ConcreteAccelerateCodeGenerator {
     std::string getFunctionName() const {return functionName;};
     std::vector<Argument> getCallBefore() const {return callBefore;};
     std::vector<Argument> getCallAfter() const {return callAfter;};
+    bool isThreadSafe() const           {return threadSafe;};
 
     template <typename Exprs> 
     ConcreteAccelerateCodeGenerator operator()(Exprs expr)
     {  std::vector<Argument> argument;
       addArg(argument, expr);
-      return ConcreteAccelerateCodeGenerator(functionName, returnType, lhs, rhs, argument, callBefore, callAfter);
+      return ConcreteAccelerateCodeGenerator(functionName, returnType, lhs, rhs, argument, callBefore, callAfter, threadSafe);
     }
 
     template <typename FirstT, typename ...Args>
     ConcreteAccelerateCodeGenerator operator()(FirstT first, Args...remaining){
         std::vector<Argument> argument;
         addArg(argument, first, remaining...);
-        return ConcreteAccelerateCodeGenerator(functionName, returnType, lhs, rhs, argument, callBefore, callAfter);
+        return ConcreteAccelerateCodeGenerator(functionName, returnType, lhs, rhs, argument, callBefore, callAfter, threadSafe);
     }
 
   private:
@@ -510,6 +522,7 @@ class ConcreteAccelerateCodeGenerator {
       std::vector<Argument> args;
       std::vector<Argument> callBefore;
       std::vector<Argument> callAfter;
+      bool threadSafe = false;
 
 };
 
@@ -554,6 +567,18 @@ struct AbstractFunctionInterface :  public util::Manageable<AbstractFunctionInte
     // performs the computation.
     virtual std::vector<Argument> callAfter() const {return {};}
 
+    // Variant of the function that performs a batch of independent problems,
+    // laid out at a constant stride, in a single call.  The batch is indexed
+    // by the first index variable of the result in the variant's statement.
+    // When holdConstant holds that index variable constant, it calls the
+    // variant once instead of calling the function in a loop.
+    virtual FunctionInterface getBatchedInterface() const {return FunctionInterface();}
+
+    // Whether independent calls to the function may be made concurrently from
+    // several threads, so that loops around the calls can be parallelized.
+    // Functions that keep global state or drive a single device are not.
+    virtual bool isThreadSafe() const {return false;}
+
     // General-purpose C++ function that can encode any other constraints that
     // the AcceleratorStmt and DynamicStmt cannot encode. 
     virtual bool checkerFunction(IndexStmt stmt) const {return true;}
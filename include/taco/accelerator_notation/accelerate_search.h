@@ -5,6 +5,10 @@
 #include "taco/index_notation/index_notation.h"
 #include "taco/accelerator_notation/accel_interface.h"
 
+#include <map>
+#include <mutex>
+#include <vector>
+
 namespace taco {
 
 
@@ -29,7 +33,24 @@ struct ArgumentMap{
 
 };
 
+/// Memoizes the op patterns of index expressions.  The rewrites explored when
+/// searching for accelerated implementations share most of their
+/// subexpressions, so their patterns need only be computed once.  A cache may
+/// be shared by several threads.
+class OpPatternCache {
+public:
+    std::vector<OpTypes> getOpPattern(IndexExpr e);
+
+private:
+    std::mutex mutex;
+    // Holding on to the expressions keeps their nodes, and so their
+    // addresses, from being reused.
+    std::map<IndexExpr, std::vector<OpTypes>> patterns;
+};
+
 std::vector<IndexExpr> allMatchedOpPatterns(IndexExpr s, AcceleratorExpr e);
+std::vector<IndexExpr> allMatchedOpPatterns(IndexExpr s, AcceleratorExpr e,
+                                            OpPatternCache* cache);
 
 bool hasOpMatch(IndexExpr e1, AcceleratorExpr e2);
 
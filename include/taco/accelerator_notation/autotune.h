@@ -0,0 +1,79 @@
+#ifndef TACO_AUTOTUNE_H
+#define TACO_AUTOTUNE_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "taco/index_notation/index_notation.h"
+#include "taco/accelerator_notation/accel_interface.h"
+
+namespace taco {
+
+/// A schedule that TensorBase::autotune may pick for a statement.  The
+/// description tells it apart from the other schedules of statements with the
+/// same tuning key, so it is what the TuningDatabase stores.
+struct TuningCandidate {
+  std::string description;
+  IndexStmt stmt;
+};
+
+/// Returns the concrete schedules to time for an assignment in reduction
+/// notation: the assignment without function interfaces, the assignment with
+/// each mapping found by IndexStmt::autoAccelerateCandidates, and, for
+/// interfaces with constraints, the mapping tiled with up to `maxTilings`
+/// tile sizes derived from GenerateSMTCode::getTilings.  Mappings that cannot
+/// be applied are skipped.
+std::vector<TuningCandidate> getTuningCandidates(IndexStmt stmt,
+                                                 const std::vector<FunctionInterface>& functionInterfaces,
+                                                 int maxTilings=4);
+
+/// Returns the schedule of getTuningCandidates with the given description,
+/// or an undefined statement if there is none.
+IndexStmt getTuningCandidate(IndexStmt stmt,
+                             const std::vector<FunctionInterface>& functionInterfaces,
+                             const std::string& description, int maxTilings=4);
+
+/// Returns the key that tuning decisions for the assignment are stored under.
+/// It covers the shape of the expression up to renaming, the types, formats
+/// and dimensions of its tensors, and the function interfaces it may map to.
+std::string getTuningKey(IndexStmt stmt,
+                         const std::vector<FunctionInterface>& functionInterfaces);
+
+/// A persistent map from tuning keys to the description of the schedule
+/// picked for them.  It is stored as a text file with one
+/// `<key hash> <description>` line per decision, where later lines take
+/// precedence, so decisions are appended as they are made.  A database
+/// without a path is kept in memory only.
+class TuningDatabase {
+public:
+  explicit TuningDatabase(const std::string& path="");
+
+  /// Returns the database at the path in TACO_TUNING_DATABASE, or else in
+  /// `tuning.db` in TACO_KERNEL_CACHE_DIR.  If neither is set, decisions
+  /// last for the lifetime of the process.
+  static TuningDatabase& getDefault();
+
+  /// Looks up the decision for the key, returning false if there is none.
+  bool lookup(const std::string& key, std::string* description);
+
+  /// Records the decision for the key.
+  void store(const std::string& key, const std::string& description);
+
+  /// Forgets every decision, including those in the file.
+  void clear();
+
+  const std::string& getPath() const;
+
+private:
+  void load();
+
+  std::string path;
+  std::mutex mutex;
+  bool loaded = false;
+  std::map<std::string, std::string> decisions;
+};
+
+}
+#endif
@@ -15,11 +15,19 @@ public:
   std::string lower(DynamicStmt stmt);
   std::string lower(DynamicExpr expr);
 
+  /// Run the generated Python/z3 query and return its output.
   std::string runSMT();
+
+  /// Check whether the constraints can be satisfied.  Queries are answered by
+  /// an in-process solver where possible, falling back to the Python/z3 query
+  /// for constraints it cannot decide (or whenever TACO_SMT_SOLVER=python),
+  /// and answers are memoized across instances.
   bool isSat();
+
+  /// Return the satisfying assignment with the largest product of values, or
+  /// an empty map if the constraints cannot be satisfied.
   std::map<IndexVar, int> getTilings();
 
-  
 
   using DynamicNotationVisitorStrict::visit;
 
@@ -47,6 +55,16 @@ public:
   void visit(const DynamicOrNode*);
 
 private:
+  /// The answer to a query, with the assignment keyed by variable name.
+  struct Solution {
+    bool sat = false;
+    std::map<std::string, int> tiling;
+  };
+
+  Solution solve();
+  bool solveNative(Solution* solution);
+  Solution solvePython();
+
   DynamicStmt stmtLower;
   std::map<DynamicOrder, std::vector<IndexVar>> dynamicOrderToVar;
   std::map<DynamicIndexIterator, int> curIterator;
@@ -0,0 +1,91 @@
+#ifndef TACO_COST_MODEL_H
+#define TACO_COST_MODEL_H
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "taco/index_notation/index_notation.h"
+#include "taco/accelerator_notation/accel_interface.h"
+
+namespace taco {
+
+/// A candidate found by IndexStmt::autoAccelerateCandidates: the rewritten
+/// statement, together with the subexpressions that it computes with calls
+/// to function interfaces.  The subexpressions belong to `rewrite`, the
+/// equivalent rewrite (in reduction notation) of the original statement that
+/// the candidate was derived from.
+struct AcceleratedCandidate {
+  IndexStmt stmt;
+  std::vector<std::pair<IndexExpr, FunctionInterface>> mappings;
+  IndexStmt rewrite;
+};
+
+/// The work done by (part of) a candidate: its floating point operations and
+/// the bytes it moves to and from memory.
+struct Work {
+  double flops = 0;
+  double bytes = 0;
+};
+
+/// Returns the work of computing the expression or statement once for every
+/// point of its iteration space.  Every operand is assumed to be dense and
+/// to be read from memory once.  Dimensions that are not known until runtime
+/// are taken to be of size one.
+Work getWork(IndexExpr expr);
+Work getWork(IndexStmt stmt);
+
+/// Predicts how long candidates of autoAccelerate take to run, so that they
+/// can be ranked without compiling them.
+class CostModel {
+public:
+  virtual ~CostModel() = default;
+
+  /// Returns the predicted time, in seconds, to compute the candidate.
+  virtual double estimate(const AcceleratedCandidate& candidate) const = 0;
+};
+
+/// A roofline cost model.  The generated code of a candidate and each of its
+/// interface calls take the longer of the time to do their operations and
+/// the time to move their operands.  Generated code runs at `flopRate`, and a
+/// function interface at the rate measured for it in the calibration table,
+/// or at `interfaceFlopRate` if it has not been calibrated.  Each interface
+/// call also costs `callOverhead` seconds.
+class AnalyticalCostModel : public CostModel {
+public:
+  AnalyticalCostModel(double flopRate=1e9, double interfaceFlopRate=1e10,
+                      double bandwidth=1e10, double callOverhead=1e-6);
+
+  /// Sets the measured rate, in floating point operations per second, of the
+  /// function interface with the given function name.
+  void calibrate(const std::string& functionName, double flopRate);
+
+  /// Reads a calibration table with one `<function name> <flops per second>`
+  /// pair per line.  Empty lines and lines starting with '#' are skipped.
+  void loadCalibration(const std::string& path);
+
+  /// Returns the rate at which the function interface is predicted to run.
+  double getFlopRate(const std::string& functionName) const;
+
+  double estimate(const AcceleratedCandidate& candidate) const;
+
+private:
+  double flopRate;
+  double interfaceFlopRate;
+  double bandwidth;
+  double callOverhead;
+  std::map<std::string, double> calibration;
+};
+
+/// Returns the candidate of IndexStmt::autoAccelerateCandidates that the
+/// cost model predicts to be fastest.  The candidates are ranked with a
+/// priority queue of piles, cheapest first; ties go to the candidate found
+/// first.
+AcceleratedCandidate selectAccelerated(IndexStmt stmt,
+                                       const std::vector<FunctionInterface>& functionInterfaces,
+                                       const CostModel& costModel,
+                                       AutoAccelerateStats* stats=nullptr);
+
+}
+#endif
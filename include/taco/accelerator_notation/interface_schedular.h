@@ -4,16 +4,30 @@
 #include <queue>
 
 #include "taco/accelerator_notation/accelerator_notation.h"
+#include "taco/accelerator_notation/accel_interface.h"
 
 class Pile {
 
     public:
         Pile(const taco::AcceleratorStmt& targetStmt) : targetStmt(targetStmt) {}
+        /// A candidate statement of autoAccelerate, the interfaces it calls,
+        /// and its predicted cost.  `id` tells candidates of equal cost apart.
+        Pile(const taco::IndexStmt& candidate,
+             const std::vector<taco::FunctionInterface>& functionInterfaces,
+             double cost, size_t id=0)
+            : functionInterfaces(functionInterfaces), candidate(candidate),
+              cost(cost), id(id) {}
         taco::AcceleratorStmt getTargetStmt() const { return targetStmt; }
        std::vector<taco::FunctionInterface> getFunctionInterface() const {return functionInterfaces; }
+        taco::IndexStmt getCandidate() const { return candidate; }
+        double getCost() const { return cost; }
+        size_t getId() const { return id; }
     private:
         taco::AcceleratorStmt targetStmt;
         std::vector<taco::FunctionInterface> functionInterfaces;
+        taco::IndexStmt candidate;
+        double cost = 0;
+        size_t id = 0;
 
 
 };
@@ -38,4 +52,4 @@ private:
 };
 
 
-#endif 
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include <string>
 #include <utility>
 #include <random>
+#include <future>
+#include <mutex>
 
 #include "taco/target.h"
 #include "taco/ir/ir.h"
@@ -22,8 +24,30 @@ public:
     setJITTmpdir();
   }
 
-  /// Compile the source into a library, returning its full path
+  ~Module();
+
+  /// Compile the source into a library, returning its full path. If the
+  /// module has a cache key and the persistent kernel cache is enabled, the
+  /// library is also stored in the cache.  With the Tiered compile tier this
+  /// returns as soon as an unoptimized library is loaded, and the optimized
+  /// library replaces it once a background compilation finishes.
   std::string compile();
+
+  /// Block until the background compilation started by a tiered compile has
+  /// finished and, if it succeeded, its optimized library is in use.
+  void waitForOptimization();
+
+  /// Set the key that identifies this module in the persistent kernel cache.
+  /// The key must capture everything, other than the compiler invocation,
+  /// that determines the generated code (e.g. the canonical form of the
+  /// statement it was lowered from).
+  void setCacheKey(std::string key);
+
+  /// Load the library for this module's cache key from the persistent kernel
+  /// cache, which is enabled by setting TACO_KERNEL_CACHE_DIR to a directory
+  /// shared by all processes. Returns false if the cache is disabled or holds
+  /// no library for the key, in which case the module must be compiled.
+  bool loadFromCache();
   
   /// Compile the module into a source file located at the specified location
   /// path and prefix.  The generated source will be path/prefix.{.c|.bc, .h}
@@ -73,7 +97,11 @@ private:
   std::stringstream header;
   std::string libname;
   std::string tmpdir;
+  std::string cacheKey;
   void* lib_handle;
+  void* unoptimizedHandle = nullptr;
+  std::mutex libHandleMutex;
+  std::future<void> optimization;
   std::vector<Stmt> funcs;
   
   // true iff the module was created from user-provided source
@@ -84,6 +112,17 @@ private:
   void setJITLibname();
   void setJITTmpdir();
 
+  /// Returns the command that compiles prefix.c into a library.  Optimized
+  /// libraries are written to prefix.so and unoptimized ones to prefix_O0.so.
+  std::string getCompileCommand(std::string prefix, bool optimize=true) const;
+  void loadLibrary(std::string fullpath);
+  void optimize(std::string prefix);
+
+  /// Returns the path, without extension, of this module's entry in the
+  /// persistent kernel cache, or the empty string if it should not be cached.
+  std::string getCachePrefix() const;
+  void storeInCache(std::string fullpath);
+
   static std::string chars;
   static std::default_random_engine gen;
   static std::uniform_int_distribution<int> randint;
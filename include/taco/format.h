@@ -67,10 +67,20 @@ public:
   /// Sets the types of the coordinate arrays for each level
   void setLevelArrayTypes(std::vector<std::vector<Datatype>> levelArrayTypes);
 
+  /// Gets the type of the positions and coordinates in the index of a tensor
+  /// with the format, which is Int32 unless set otherwise.
+  Datatype getIndexType() const;
+
+  /// Sets the type of the positions and coordinates in the index, and of the
+  /// coordinate arrays of every level, to Int32 or Int64.  Tensors with more
+  /// than 2^31-1 stored components must use Int64.
+  void setIndexType(Datatype indexType);
+
 private:
   std::vector<ModeFormatPack> modeFormatPacks;
   std::vector<int> modeOrdering;
   std::vector<std::vector<Datatype>> levelArrayTypes;
+  Datatype indexType = Datatype(Datatype::Int32);
 };
 
 bool operator==(const Format&, const Format&);
@@ -149,6 +159,14 @@ public:
       std::vector<IndexVar> parentCoords, 
       std::vector<IndexVar> childCoords) const;
 
+  /// Returns the size of the mode if it is fixed by the mode format (as for
+  /// the modes inside the blocks of a block-sparse format), or 0 otherwise.
+  int getFixedSize() const;
+
+  /// Returns the number of slots of the hash tables of a hashed mode of the
+  /// given dimension, or 0 if the mode is not hashed.
+  int getTableSize(int dimension) const;
+
   /// Returns true if mode format is defined, false otherwise. An undefined mode
   /// type can be used to indicate a mode whose format is not (yet) known.
   bool defined() const;
@@ -201,6 +219,38 @@ extern const Format CSC;
 extern const Format DCSR;
 extern const Format DCSC;
 
+/// A dense mode of fixed size `blockSize`, for the modes inside the blocks of
+/// block-sparse formats.  Blocks are stored contiguously in the values.
+ModeFormat DenseBlock(int blockSize);
+
+/// A mode that stores the coordinates below each parent position in a hash
+/// table of `tableSize` slots (the dimension of the mode if 0).  A table must
+/// have more slots than coordinates, unless it is as large as the dimension.
+/// Hashed modes support inserting coordinates in any order, and can be the
+/// result of computations whose result structure is not known in advance;
+/// convert them to ordered formats with `removeExplicitZeros(format)`.
+ModeFormat Hashed(int tableSize=0);
+
+/// A mode that marks the coordinates below each parent position in a bitset,
+/// for modes that are too dense for compressed coordinate lists but too sparse
+/// to store densely.  Intersections of bitmap modes are computed a 64-bit word
+/// at a time.  Bitmap modes can be assembled below dense modes.
+extern const ModeFormat Bitmap;
+
+/// Block compressed sparse row: a CSR matrix of dense blockRows x blockCols
+/// blocks, stored as a 4-tensor with dimensions
+/// (rows/blockRows, cols/blockCols, blockRows, blockCols).
+const Format BCSR(int blockRows, int blockCols);
+
+/// Block compressed sparse fiber: a CSF tensor of dense blocks of the given
+/// sizes, stored as a tensor of twice the order of the blocks.
+const Format BCSF(const std::vector<int>& blockSizes);
+
+/// Sliced ELLPACK with slices of `sliceSize` rows: the format of the
+/// (slice, slot, row-in-slice, column) tensors built by packSELL, which store
+/// the k-th nonzeros of the rows of a slice next to each other.
+const Format SELL(int sliceSize);
+
 const Format COO(int order, bool isUnique = true, bool isOrdered = true, 
                  bool isAoS = false, const std::vector<int>& modeOrdering = {});
 /// @}
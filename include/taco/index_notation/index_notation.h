@@ -35,6 +35,7 @@ class Format;
 class Schedule;
 class ConcreteAccelerateCodeGenerator;
 class FunctionInterface;
+struct AcceleratedCandidate;
 
 class IndexVar;
 class WindowedIndexVar;
@@ -596,6 +597,25 @@ template <typename SubType> bool isa(IndexStmt);
 /// the subtypes are Assignment, Forall, Where, Multi, and Sequence.
 template <typename SubType> SubType to(IndexStmt);
 
+/// Statistics about a call to IndexStmt::autoAccelerate.
+struct AutoAccelerateStats {
+  /// The number of equivalent rewrites of the statement that were generated,
+  /// and the number that remained after dropping those that are identical up
+  /// to renaming.
+  size_t rewrites = 0;
+  size_t uniqueRewrites = 0;
+
+  /// The number of candidate statements returned.
+  size_t candidates = 0;
+
+  /// The (expression, function name) pairs of every expression that matched
+  /// a function interface.
+  std::set<std::pair<std::string, std::string>> mappings;
+
+  /// The time taken by the search, in seconds.
+  double seconds = 0;
+};
+
 /// A an index statement computes a tensor.  The index statements are
 /// assignment, forall, where, multi, and sequence.
 class IndexStmt : public util::IntrusivePtr<const IndexStmtNode> {
@@ -617,7 +637,17 @@ public:
   IndexStmt concretize() const;
   IndexStmt concretizeAccelerated(const std::vector<FunctionInterface>& functionInterface) const;
 
-  std::vector<IndexStmt> autoAccelerate(IndexStmt stmt, std::vector<FunctionInterface> functionInterface) const;
+  /// Returns the candidate rewrites of `stmt` in which subexpressions are
+  /// replaced with calls to the given function interfaces.  The equivalent
+  /// rewrites of `stmt` are matched against the interfaces in parallel.  If
+  /// `stats` is given it is filled in with statistics about the search.
+  std::vector<IndexStmt> autoAccelerate(IndexStmt stmt, std::vector<FunctionInterface> functionInterface,
+                                        AutoAccelerateStats* stats=nullptr) const;
+
+  /// Returns the same candidates as autoAccelerate, each together with the
+  /// subexpressions it maps to function interfaces.
+  std::vector<AcceleratedCandidate> autoAccelerateCandidates(IndexStmt stmt, std::vector<FunctionInterface> functionInterface,
+                                                             AutoAccelerateStats* stats=nullptr) const;
   IndexStmt helperCheckForMatches(IndexStmt stmt, std::vector<FunctionInterface> functionInterfaces, std::set<std::pair<std::string, std::string>>& expressions) const;
   IndexExpr tryIndicesConstant(AcceleratorExpr toMatch, IndexExpr stmt, bool& success) const;
   IndexExpr tryPromotion(AcceleratorExpr toMatch, IndexExpr stmt, bool& success) const;
@@ -822,6 +852,12 @@ public:
 /// Check if two index statements are isomorphic.
 bool isomorphic(IndexStmt, IndexStmt);
 
+/// Returns a textual form of the index statement in which tensors and index
+/// variables are renamed in order of first appearance, followed by the type
+/// and format of every tensor. Statements that differ only in the names of
+/// their tensors and index variables have the same canonical string.
+std::string toCanonicalString(IndexStmt);
+
 /// Compare two index statments by value.
 bool equals(IndexStmt, IndexStmt);
 
@@ -977,7 +1013,8 @@ class DimReduction : public IndexStmt {
 public:
   DimReduction() = default;
   DimReduction(const DimReductionNode*);
-  DimReduction(IndexStmt consumer, IndexStmt producer, std::vector<TensorVar> temps);
+  DimReduction(IndexStmt consumer, IndexStmt producer, std::vector<TensorVar> temps,
+               std::map<TensorVar, Access> aliases = {});
 
   IndexStmt getConsumer();
   IndexStmt getProducer();
@@ -986,6 +1023,13 @@ public:
    */
   std::vector<TensorVar> getTemporaries();
 
+  /**
+   * Retrieve the temporaries that are not gathered into, because the slice of
+   * the operand they hold is already stored contiguously in the layout the
+   * temporary expects.  Each temporary maps to the operand access it aliases.
+   */
+  std::map<TensorVar, Access> getAliases();
+
   typedef DimReductionNode Node;
 };
 
@@ -993,12 +1037,21 @@ class InterfaceCall : public IndexStmt {
 public:
   InterfaceCall() = default;
   InterfaceCall(const InterfaceCallNode*);
-  InterfaceCall(Assignment producer, ConcreteAccelerateCodeGenerator accelGen, TensorVar temp);
+  InterfaceCall(Assignment producer, ConcreteAccelerateCodeGenerator accelGen, TensorVar temp,
+                IndexStmt remainder = IndexStmt());
 
   Assignment getProducer();
   ConcreteAccelerateCodeGenerator getAccelGen();
   TensorVar getTemporary();
 
+  /**
+   * Returns the generated code that computes the producer instead of the
+   * call for partial tiles, i.e. when a tile overhangs the end of an index
+   * variable that does not divide evenly into tiles.  Undefined if the call
+   * is not tiled, in which case it is always made.
+   */
+  IndexStmt getRemainder();
+
   typedef InterfaceCallNode Node;
 
 };
@@ -452,8 +452,9 @@ struct AccelerateNode : public IndexStmtNode {
 };
 
 struct DimReductionNode : public IndexStmtNode {
-  DimReductionNode(IndexStmt consumer, IndexStmt producer,  std::vector<TensorVar> temps)
-      : consumer(consumer), producer(producer), temps(temps) {}
+  DimReductionNode(IndexStmt consumer, IndexStmt producer,  std::vector<TensorVar> temps,
+                   std::map<TensorVar, Access> aliases = {})
+      : consumer(consumer), producer(producer), temps(temps), aliases(aliases) {}
 
   void accept(IndexStmtVisitorStrict* v) const {
     v->visit(this);
@@ -462,11 +463,13 @@ struct DimReductionNode : public IndexStmtNode {
   IndexStmt consumer;
   IndexStmt producer;
   std::vector<TensorVar> temps;
+  std::map<TensorVar, Access> aliases;
 };
 
 struct InterfaceCallNode : public IndexStmtNode {
-  InterfaceCallNode(Assignment producer, ConcreteAccelerateCodeGenerator codeGen, TensorVar temp) 
-    : producer(producer), codeGen(codeGen), temp(temp) {} 
+  InterfaceCallNode(Assignment producer, ConcreteAccelerateCodeGenerator codeGen, TensorVar temp,
+                    IndexStmt remainder = IndexStmt())
+    : producer(producer), codeGen(codeGen), temp(temp), remainder(remainder) {}
 
   void accept(IndexStmtVisitorStrict* v) const {
     v->visit(this);
@@ -475,6 +478,7 @@ struct InterfaceCallNode : public IndexStmtNode {
   Assignment producer;
   ConcreteAccelerateCodeGenerator codeGen;
   TensorVar temp;
+  IndexStmt remainder;
 };
 
 struct MultiNode : public IndexStmtNode {
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <memory>
+#include <string>
 
 namespace taco {
 
@@ -24,9 +25,12 @@ public:
   /// Construct an undefined kernel.
   Kernel();
 
-  /// Construct a kernel from relevant function pointers and a module.
+  /// Construct a kernel from relevant function pointers and a module.  The
+  /// prefix is prepended to the names of the kernel functions in the module,
+  /// which lets several kernels share one module.
   Kernel(IndexStmt stmt, std::shared_ptr<ir::Module> module,
-         void* evaluate, void* assemble, void* compute);
+         void* evaluate, void* assemble, void* compute,
+         std::string prefix="");
 
   /// Evaluate the kernel on the given tensor storage arguments, which includes
   /// allocating memory, assembling indices, and computing component values.
@@ -54,6 +58,13 @@ public:
   }
   /// @}
 
+  /// Get a pointer to the raw evaluate, assemble or compute function.
+  /// @{
+  void* getEvaluateFunction() const;
+  void* getAssembleFunction() const;
+  void* getComputeFunction() const;
+  /// @}
+
   /// Check whether the kernel is defined.
   bool defined();
 
@@ -72,5 +83,12 @@ private:
 /// Compile a concrete index notation statement to a runnable kernel.
 Kernel compile(IndexStmt stmt);
 
+/// Compile many concrete index notation statements to runnable kernels that
+/// share a single module.  The functions of every statement are emitted into
+/// one translation unit, with the symbols of the i'th statement prefixed by
+/// `k<i>_`, so the whole batch costs one compiler invocation and one dlopen.
+/// The i'th returned kernel executes the i'th statement.
+std::vector<Kernel> compile(const std::vector<IndexStmt>& stmts);
+
 }
 #endif
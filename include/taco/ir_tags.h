@@ -35,8 +35,12 @@ extern const char *AssembleStrategy_NAMES[];
 
 /// MergeStrategy::TwoFinger merges iterators by incrementing one at a time
 /// MergeStrategy::Galloping merges iterators by exponential search (galloping)
+/// MergeStrategy::SIMDBlock merges iterators by comparing blocks of
+///   coordinates against the current coordinate with vector instructions
+/// MergeStrategy::MergePath merges iterators in parallel partitions of about
+///   equal size, split along the merge path of their coordinates
 enum class MergeStrategy {
-  TwoFinger, Gallop
+  TwoFinger, Gallop, SIMDBlock, MergePath
 };
 extern const char *MergeStrategy_NAMES[];
 
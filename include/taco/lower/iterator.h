@@ -144,6 +144,11 @@ public:
   /// Returns code for level function that implements locate capability.
   ModeFunction locate(const std::vector<ir::Expr>& coords) const;
 
+  /// Returns true if the level marks its coordinates in bitsets, whose words
+  /// can be loaded with `getBitsetWord`.
+  bool hasBitset() const;
+  ir::Expr getBitsetWord(const ir::Expr& word) const;
+
   /// Return code for level functions that implement insert capabilitiy.
   ir::Stmt getInsertCoord(const ir::Expr& p,
                           const std::vector<ir::Expr>& i) const;
@@ -86,6 +86,18 @@ protected:
                                         std::set<Access> reducedAccesses,
                                         ir::Stmt recoveryStmt);
 
+  /// Lower a forall that iterates over the coordinates marked in the bitsets
+  /// of the bitset iterators, intersecting them a 64-bit word at a time, and
+  /// locates tensor positions from the locate iterators.
+  virtual ir::Stmt lowerForallBitset(Forall forall,
+                                     std::vector<Iterator> bitsets,
+                                     std::vector<Iterator> locaters,
+                                     std::vector<Iterator> inserters,
+                                     std::vector<Iterator> appenders,
+                                     MergeLattice caseLattice,
+                                     std::set<Access> reducedAccesses,
+                                     ir::Stmt recoveryStmt);
+
   /// Lower a forall that iterates over all the coordinates in the forall index
   /// var's dimension, and locates tensor positions from the locate iterators.
   virtual ir::Stmt lowerForallDenseAcceleration(Forall forall,
@@ -149,7 +161,8 @@ protected:
      *      A concrete index notation statement to compute at the points in the
      *      sparse iteration space described by the merge lattice.
      * \param mergeStrategy
-     *      A strategy for merging iterators. One of TwoFinger or Gallop.
+     *      A strategy for merging iterators. One of TwoFinger, Gallop,
+     *      SIMDBlock, or MergePath.
      *
      * \return
      *       IR code to compute the forall loop.
@@ -159,6 +172,18 @@ protected:
                                      const std::set<Access>& reducedAccesses, 
                                      MergeStrategy mergeStrategy);
 
+  /**
+   * Lower the merge loops of a lattice that co-iterates two compressed modes
+   * to a parallel loop over partitions of about equal length along the merge
+   * path of their coordinates.  Each partition restricts the iterators to a
+   * range of coordinates before running the merge loops.  Returns an undefined
+   * statement if the lattice cannot be partitioned.
+   */
+  virtual ir::Stmt lowerMergePathPartitions(MergeLattice lattice,
+                                            IndexVar coordinateVar,
+                                            ir::Stmt iteratorVarInits,
+                                            ir::Stmt mergeLoops);
+
   virtual ir::Stmt resolveCoordinate(std::vector<Iterator> mergers, ir::Expr coordinate, bool emitVarDecl, bool mergeWithMax);
 
     /**
@@ -176,7 +201,8 @@ protected:
      *      sparse iteration space region described by the merge point.
      * \param mergeWithMax
      *      A boolean indicating whether coordinates should be combined with MAX instead of MIN.
-     *      MAX is needed when the iterators are merged with the Gallop strategy.
+     *      MAX is needed when the iterators are merged with the Gallop or
+     *      SIMDBlock strategies.
      */
   virtual ir::Stmt lowerMergePoint(MergeLattice pointLattice,
                                    ir::Expr coordinate, IndexVar coordinateVar, IndexStmt statement,
@@ -373,6 +399,10 @@ protected:
   /// Declare position variables and initialize them with a locate.
   ir::Stmt declLocatePosVars(std::vector<Iterator> iterators);
 
+  /// Insert the coordinates at the located positions of inserters whose
+  /// modes store coordinates (e.g., hashed modes).
+  ir::Stmt insertCoordinates(std::vector<Iterator> inserters);
+
   /// Emit loops to reduce duplicate coordinates.
   ir::Stmt reduceDuplicateCoordinates(ir::Expr coordinate, 
                                       std::vector<Iterator> iterators, 
@@ -404,6 +434,10 @@ protected:
   std::vector<ir::Stmt> codeToInitializeTemporary(Accelerate where);
   std::vector<std::vector<ir::Stmt>> codeToInitializeTemporary(DimReduction dimReduction);
 
+  /// Points the temporaries that alias operand slices, and that are accessed in
+  /// a statement, at the slices selected by the enclosing loops.
+  ir::Stmt codeToBindAliasedTemporaries(IndexStmt stmt);
+
   std::vector<ir::Stmt> codeToInitializeTemporaryParallel(Where where, ParallelUnit parallelUnit);
     // std::vector<ir::Stmt> codeToInitializeTemporaryParallel(Accelerate where, ParallelUnit parallelUnit);
 
@@ -572,6 +606,15 @@ private:
   };
   std::map<TensorVar, TemporaryArrays> temporaryArrays;
 
+  /// Map from temporaries that alias a contiguous slice of an operand, instead
+  /// of holding a gathered copy of it, to the access of that operand.
+  std::map<TensorVar, Access> temporaryAliases;
+
+  /// Map from temporaries that every thread of a parallelized loop around
+  /// interface calls has its own copy of, to the declaration of that copy.
+  /// The declarations are emitted in the loop, where the temporaries are used.
+  std::map<TensorVar, ir::Stmt> threadPrivateTemporaries;
+
   /// Map form temporary to indexList var if accelerating dense workspace
   std::map<TensorVar, ir::Expr> tempToIndexList;
 
@@ -633,6 +676,14 @@ private:
   /// Set of locate-capable iterators that can be legally accessed.
   util::ScopedSet<Iterator> accessibleIterators;
 
+  /// Map from locators whose locate can miss (e.g., bitmap modes) to the
+  /// expressions that report whether the located coordinate is stored.
+  std::map<Iterator, ir::Expr> locateFoundExprs;
+
+  /// Bitset iterators whose set bits the loop being lowered iterates over, so
+  /// their located coordinates are known to be stored.
+  std::set<Iterator> bitsetIterators;
+
   /// Visitor methods can add code to emit it to the function header.
   std::vector<ir::Stmt> header;
 
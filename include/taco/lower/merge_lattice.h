@@ -65,6 +65,10 @@ public:
   /// Returns true if we need to emit checks for explicit zeros in the lattice given.
   bool needExplicitZeroChecks();
 
+  /// Returns true if some point locates a coordinate in a mode that may not
+  /// store it, such as a bitmap mode.
+  bool anyLocatorMayMiss() const;
+
   /**
    * Returns the sub-lattice rooted at the given merge point.
    */
@@ -20,9 +20,11 @@ public:
   /// Construct an undefined mode.
   Mode();
 
-  /// Construct a tensor mode.
+  /// Construct a tensor mode.  Positions in the mode, and the variables that
+  /// hold them, are of type `indexType`.
   Mode(ir::Expr tensor, Dimension size, int mode, ModeFormat modeFormat,
-       ModePack modePack, size_t packLoc, ModeFormat parentModeFormat);
+       ModePack modePack, size_t packLoc, ModeFormat parentModeFormat,
+       Datatype indexType=Int32);
 
   /// Retrieve the name of the tensor mode.
   std::string getName() const;
@@ -49,6 +51,9 @@ public:
   /// Retrieve the mode type of the parent mode in the mode hierarchy.
   ModeFormat getParentModeType() const;
 
+  /// Retrieve the type of positions in the mode.
+  Datatype getIndexType() const;
+
   /// Store temporary variables that may be needed to access or modify a mode
   /// @{
   ir::Expr getVar(std::string varName) const;
@@ -73,8 +78,10 @@ std::ostream& operator<<(std::ostream&, const Mode&);
 class ModePack {
 public:
   ModePack();
-  ModePack(size_t numModes, ModeFormat modeType, ir::Expr tensor, int mode, 
-           int level);
+  /// Construct the arrays of a mode pack.  The i-th index array of the pack
+  /// is of type `arrayTypes[i]`, if given, and of type Int32 otherwise.
+  ModePack(size_t numModes, ModeFormat modeType, ir::Expr tensor, int mode,
+           int level, const std::vector<Datatype>& arrayTypes={});
 
   /// Returns number of tensor modes belonging to mode pack.
   size_t getNumModes() const;
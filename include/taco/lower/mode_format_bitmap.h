@@ -0,0 +1,54 @@
+#ifndef TACO_MODE_FORMAT_BITMAP_H
+#define TACO_MODE_FORMAT_BITMAP_H
+
+#include "taco/lower/mode_format_impl.h"
+
+namespace taco {
+
+/// A mode that marks the coordinates below each parent position in a bitset
+/// of 64-bit words, with one bit per coordinate.  A second array holds, for
+/// every word, the number of coordinates stored before it, so the position of
+/// a coordinate is that count plus the number of bits set below it in its
+/// word.  Bitmaps suit modes that are too dense for compressed coordinate
+/// lists but too sparse to store densely, and bitmap modes that are
+/// intersected are co-iterated a word at a time.
+class BitmapModeFormat : public ModeFormatImpl {
+public:
+  using ModeFormatImpl::getAppendCoord;
+
+  BitmapModeFormat();
+  BitmapModeFormat(bool isZeroless);
+
+  ~BitmapModeFormat() override {}
+
+  ModeFormat copy(std::vector<ModeFormat::Property> properties) const override;
+
+  ModeFunction locate(ir::Expr parentPos, std::vector<ir::Expr> coords,
+                      Mode mode) const override;
+
+  ir::Stmt getAppendCoord(ir::Expr parentPos, ir::Expr pos, ir::Expr coord,
+                          Mode mode) const override;
+  ir::Expr getSize(ir::Expr parentSize, Mode mode) const override;
+  ir::Stmt getAppendInitLevel(ir::Expr parentSize, ir::Expr size,
+                              Mode mode) const override;
+  ir::Stmt getAppendFinalizeLevel(ir::Expr parentSize, ir::Expr size,
+                                  Mode mode) const override;
+
+  std::vector<ir::Expr> getArrays(ir::Expr tensor, int mode,
+                                  int level) const override;
+
+  ir::Expr getBitsetWord(ir::Expr parentPos, ir::Expr word,
+                         Mode mode) const override;
+
+protected:
+  ir::Expr getSizeArray(ModePack pack) const;
+  ir::Expr getPosArray(ModePack pack) const;
+  ir::Expr getBitsArray(ModePack pack) const;
+
+  /// Returns the number of words in the bitset below each parent position.
+  ir::Expr getNumWords(Mode mode) const;
+};
+
+}
+
+#endif
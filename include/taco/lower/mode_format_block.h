@@ -0,0 +1,38 @@
+#ifndef TACO_MODE_FORMAT_BLOCK_H
+#define TACO_MODE_FORMAT_BLOCK_H
+
+#include "taco/lower/mode_format_dense.h"
+
+namespace taco {
+
+/// A dense mode whose size is fixed by the format, for the modes inside the
+/// blocks of block-sparse formats such as BCSR and BCSF.  Modes of this format
+/// are stored exactly like dense modes, so each block is stored contiguously
+/// in the values (and can be handed to a dense kernel as is).  Because the
+/// size is known when the code is generated, loops over the mode have
+/// constant bounds and dense block computations become fixed-size loop nests
+/// that the backend compiler unrolls and vectorizes.
+class BlockModeFormat : public DenseModeFormat {
+public:
+  BlockModeFormat(int blockSize);
+  BlockModeFormat(int blockSize, const bool isOrdered, const bool isUnique,
+                  const bool isZeroless);
+
+  ~BlockModeFormat() override {}
+
+  ModeFormat copy(std::vector<ModeFormat::Property> properties) const override;
+
+  ir::Expr getWidth(Mode mode) const override;
+
+  int getFixedSize() const override;
+
+protected:
+  bool equals(const ModeFormatImpl& other) const override;
+
+private:
+  int blockSize;
+};
+
+}
+
+#endif
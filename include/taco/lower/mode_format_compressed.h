@@ -8,6 +8,7 @@ namespace taco {
 class CompressedModeFormat : public ModeFormatImpl {
 public:
   using ModeFormatImpl::getInsertCoord;
+  using ModeFormatImpl::getAppendCoord;
 
   CompressedModeFormat();
   CompressedModeFormat(bool isFull, bool isOrdered,
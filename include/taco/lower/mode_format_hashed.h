@@ -0,0 +1,72 @@
+#ifndef TACO_MODE_FORMAT_HASHED_H
+#define TACO_MODE_FORMAT_HASHED_H
+
+#include "taco/lower/mode_format_impl.h"
+
+namespace taco {
+
+/// A mode that stores the coordinates below each parent position in a hash
+/// table with open addressing (linear probing).  Each table has a fixed
+/// number of slots, which is the size of the mode unless given, and empty
+/// slots hold coordinate -1 and the fill value.  Coordinates are located and
+/// inserted in constant expected time, in any order, so the format suits the
+/// results of scatter-heavy computations (e.g., the rows of a sparse matrix
+/// product) whose structure is not known in advance.  Iterating over a hashed
+/// mode visits its coordinates in no particular order.
+class HashedModeFormat : public ModeFormatImpl {
+public:
+  HashedModeFormat();
+  HashedModeFormat(int tableSize);
+  HashedModeFormat(bool isZeroless, int tableSize);
+
+  ~HashedModeFormat() override {}
+
+  ModeFormat copy(std::vector<ModeFormat::Property> properties) const override;
+
+  ModeFunction posIterBounds(ir::Expr parentPos, Mode mode) const override;
+  ModeFunction posIterAccess(ir::Expr pos, std::vector<ir::Expr> coords,
+                             Mode mode) const override;
+
+  ModeFunction locate(ir::Expr parentPos, std::vector<ir::Expr> coords,
+                      Mode mode) const override;
+
+  ir::Stmt getInsertCoord(ir::Expr p, const std::vector<ir::Expr>& i,
+                          Mode mode) const override;
+  ir::Expr getWidth(Mode mode) const override;
+  ir::Stmt getInsertInitCoords(ir::Expr pBegin, ir::Expr pEnd,
+                               Mode mode) const override;
+  ir::Stmt getInsertInitLevel(ir::Expr szPrev, ir::Expr sz,
+                              Mode mode) const override;
+  ir::Stmt getInsertFinalizeLevel(ir::Expr szPrev, ir::Expr sz,
+                                  Mode mode) const override;
+
+  ir::Expr getAssembledSize(ir::Expr prevSize, Mode mode) const override;
+  ir::Stmt getInitCoords(ir::Expr prevSize,
+                         std::vector<AttrQueryResult> queries,
+                         Mode mode) const override;
+  ModeFunction getYieldPos(ir::Expr parentPos, std::vector<ir::Expr> coords,
+                           Mode mode) const override;
+  ir::Stmt getInsertCoord(ir::Expr parentPos, ir::Expr pos,
+                          std::vector<ir::Expr> coords,
+                          Mode mode) const override;
+
+  std::vector<ir::Expr> getArrays(ir::Expr tensor, int mode,
+                                  int level) const override;
+
+  int getTableSize(int dimension) const override;
+
+protected:
+  ir::Expr getSizeArray(ModePack pack) const;
+  ir::Expr getCoordArray(ModePack pack) const;
+
+  /// Returns code that initializes the slots in [begin, end) to be empty.
+  ir::Stmt clearSlots(ir::Expr begin, ir::Expr end, Mode mode) const;
+
+  bool equals(const ModeFormatImpl& other) const override;
+
+  const int tableSize;
+};
+
+}
+
+#endif
@@ -185,6 +185,11 @@ public:
   virtual ir::Stmt
   getAppendCoord(ir::Expr p, ir::Expr i, Mode mode) const;
 
+  /// Appends coordinate `i` at position `p` below parent position `pPrev`.
+  /// Defaults to the variant that does not take the parent position.
+  virtual ir::Stmt
+  getAppendCoord(ir::Expr pPrev, ir::Expr p, ir::Expr i, Mode mode) const;
+
   virtual ir::Stmt
   getAppendEdges(ir::Expr pPrev, ir::Expr pBegin, ir::Expr pEnd,
                  Mode mode) const;
@@ -236,6 +241,20 @@ public:
   virtual std::vector<ir::Expr>
   getArrays(ir::Expr tensor, int mode, int level) const = 0;
 
+  /// Returns the size of modes of this format if the format fixes it, or 0
+  /// if modes of the format can be of any size.
+  virtual int getFixedSize() const;
+
+  /// Returns the number of slots of the hash tables of modes of this format
+  /// with the given dimension, or 0 if modes of the format are not hashed.
+  virtual int getTableSize(int dimension) const;
+
+  /// Returns the `word`-th 64-bit word of the bitset that marks the
+  /// coordinates stored below `parentPos`, or an undefined expression if modes
+  /// of the format do not store their coordinates in bitsets.
+  virtual ir::Expr getBitsetWord(ir::Expr parentPos, ir::Expr word,
+                                 Mode mode) const;
+
   friend bool operator==(const ModeFormatImpl&, const ModeFormatImpl&);
   friend bool operator!=(const ModeFormatImpl&, const ModeFormatImpl&);
 
@@ -8,6 +8,7 @@ namespace taco {
 class SingletonModeFormat : public ModeFormatImpl {
 public:
   using ModeFormatImpl::getInsertCoord;
+  using ModeFormatImpl::getAppendCoord;
 
   SingletonModeFormat();
   SingletonModeFormat(bool isFull, bool isOrdered, bool isUnique, 
@@ -0,0 +1,53 @@
+/// Read and write taco's binary tensor format, which holds the packed storage
+/// of a tensor as is: its dimensions, format, index arrays and values.
+
+#ifndef TACO_FILE_IO_BIN_H
+#define TACO_FILE_IO_BIN_H
+
+#include <istream>
+#include <ostream>
+#include <string>
+
+#include "taco/format.h"
+
+namespace taco {
+class TensorBase;
+class TensorStorage;
+class Format;
+
+/// Read a binary tensor from a file.  The file is memory mapped (copy on
+/// write) and the index and value arrays of the tensor point into the
+/// mapping, which lasts as long as any of them, so loading neither parses nor
+/// copies the data.  The tensor must have been written in the given format
+/// and is always returned packed.
+TensorBase readBinary(std::string filename, const ModeFormat& modetype,
+                      bool pack=true);
+
+/// Read a binary tensor from a file.
+TensorBase readBinary(std::string filename, const Format& format,
+                      bool pack=true);
+
+/// Read a binary tensor from a stream, copying its arrays.
+TensorBase readBinary(std::istream& stream, const ModeFormat& modetype,
+                      bool pack=true);
+
+/// Read a binary tensor from a stream, copying its arrays.
+TensorBase readBinary(std::istream& stream, const Format& format,
+                      bool pack=true);
+
+/// Write the packed storage of a tensor to a binary file.
+void writeBinary(std::string filename, const TensorBase& tensor);
+
+/// Write the packed storage of a tensor to a binary stream.
+void writeBinary(std::ostream& stream, const TensorBase& tensor);
+
+/// Write tensor storage to a binary file.  The index and value arrays are
+/// written as they are, without iterating over the components.
+void writeBinary(std::string filename, const TensorStorage& storage);
+
+/// Write tensor storage to a binary stream.
+void writeBinary(std::ostream& stream, const TensorStorage& storage);
+
+}
+
+#endif
@@ -23,6 +23,17 @@ namespace ir {
 class Stmt;
 }
 
+/// Sorts a coordinate buffer, whose components are `modeOrdering.size()` int
+/// coordinates followed by a value of `valueSize` bytes, lexicographically by
+/// their coordinates in the given mode ordering, and writes the (reordered)
+/// coordinates of each mode and the values of the sorted components to
+/// `coordinates` and `values`.  Input that is already sorted is only copied;
+/// otherwise the coordinates are linearized and radix sorted in parallel.
+void sortCoordinates(const char* components, size_t numComponents,
+                     size_t componentSize, const std::vector<int>& modeOrdering,
+                     size_t valueSize,
+                     std::vector<std::vector<int>>& coordinates, char* values);
+
 TensorStorage pack(Datatype                             datatype,
                    const std::vector<int>&              dimensions,
                    const Format&                        format,
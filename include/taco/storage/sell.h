@@ -0,0 +1,33 @@
+/// Build the sliced ELLPACK (SELL-C-sigma) representation of sparse matrices,
+/// whose SpMV kernels compute C rows at a time in full-width SIMD lanes.
+
+#ifndef TACO_SELL_H
+#define TACO_SELL_H
+
+#include <vector>
+
+namespace taco {
+class TensorBase;
+
+/// Returns the SELL-C-sigma representation of the matrix `matrix`, with
+/// slices of C = `sliceSize` rows.  The rows are first sorted by decreasing
+/// number of nonzeros within windows of `sortWindow` rows, then cut into
+/// slices, and every row of a slice is padded (with explicit zeros) to the
+/// length of the longest row in the slice.
+///
+/// The result is a tensor S of format SELL(sliceSize) and dimensions
+/// (slices, width, sliceSize, columns), where S(s,k,c,j) is the k-th nonzero
+/// of row c of slice s and j is its column.  The k-th nonzeros of the rows of
+/// a slice are stored next to each other, so SpMV
+///
+///   y(s,c) = S(s,k,c,j) * x(j)
+///
+/// computes `sliceSize` rows at once with contiguous, unit-stride loads of
+/// the values and coordinates.  Row c of slice s of S (and y) is row
+/// `rowPermutation[s*sliceSize + c]` of the matrix, or padding if that is -1.
+TensorBase packSELL(const TensorBase& matrix, int sliceSize, int sortWindow,
+                    std::vector<int>* rowPermutation=nullptr);
+
+}
+
+#endif
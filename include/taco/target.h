@@ -18,6 +18,14 @@ struct Target {
   std::string compiler_env = "TACO_CC";
 
   std::string compiler = "cc";
+
+  /// How much time to spend compiling generated code.  Optimized kernels are
+  /// compiled with full optimization before they are run.  Fast kernels are
+  /// compiled without optimization, which is several times quicker and suits
+  /// kernels that run only briefly.  Tiered kernels are first compiled as Fast
+  /// kernels and then recompiled with full optimization in the background,
+  /// replacing the fast build once the optimized build is ready.
+  enum CompileTier {Optimized=0, Fast, Tiered} compileTier = Optimized;
   
   // As we support them, we'll stick in optional features into the target as
   // well, including things like parallelism model (e.g. openmp, cilk) for
@@ -38,7 +46,9 @@ struct Target {
 };
 
   /// Gets the target from the environment.  If this is not set in the
-  /// environment, it uses the default C99 backend with the current OS
+  /// environment, it uses the default C99 backend with the current OS.  The
+  /// compile tier is read from TACO_COMPILE_TIER, which may be one of
+  /// `optimized` (the default), `fast`, or `tiered`.
   Target getTargetFromEnvironment();
 
 } // namespace taco
@@ -8,6 +8,9 @@
 #include <utility>
 #include <array>
 #include <mutex>
+#include <future>
+#include <shared_mutex>
+#include <unordered_map>
 
 #include "taco/type.h"
 #include "taco/format.h"
@@ -169,6 +172,13 @@ public:
   template <typename CType>
   void insert(const std::vector<int>& coordinate, CType value);
 
+  /// Appends `numComponents` components to the components to be packed and
+  /// returns the memory the caller must write them to, for readers that
+  /// produce many components at once.  Each component is `getOrder()` ints
+  /// holding its coordinates followed by its value of the component type.
+  /// The coordinates are not checked.
+  char* appendComponents(size_t numComponents);
+
   /// Fill the tensor with the list of components defined by the iterator range (begin, end).
   ///
   /// The input list of triplets does not have to be sorted, and can contains duplicated elements.
@@ -443,7 +453,8 @@ public:
 
   /* --- Compiler Methods    --- */
 
-  /// Pack tensor into the given format
+  /// Pack tensor into the given format. Different tensors may be built and
+  /// packed concurrently from different threads.
   void pack();
 
   /// register a backend that we can autoschedule to
@@ -456,11 +467,31 @@ public:
 
   /// Compile the tensor expression.
   void compile();
+
+  /// Compile the tensor expression on a background thread and return a future
+  /// that becomes ready (or holds the compilation error) once the kernel is
+  /// loaded. Assemble, compute and evaluate wait for the pending compilation,
+  /// so the caller can overlap it with other work such as packing operands.
+  /// The tensor's expression must not be changed until the future is ready.
+  std::shared_future<void> compileAsync();
   void compileAccelerated(std::vector<IndexExpr> AcceleratedExpressions);
 
   void compile(IndexStmt stmt, bool assembleWhileCompute=false);
+
+  /// Compile the tensor expression, mapping it to the given function
+  /// interfaces.  If the expression has been autotuned for these interfaces
+  /// the schedule recorded in the tuning database is used.
   void compileAccelerated(taco::IndexStmt stmt, std::vector<FunctionInterface> functionInterface, bool assembleWhileCompute=false);
 
+  /// Compile every schedule of getTuningCandidates for the tensor expression
+  /// and the registered accelerators, time assembling and computing it on
+  /// the operands `warmup + repetitions` times, and record the schedule with
+  /// the fastest of the timed runs in the default TuningDatabase.  The tensor
+  /// is left compiled with that schedule, but must still be assembled and
+  /// computed.  Schedules that fail to compile or run are skipped.  Returns
+  /// the description of the schedule.
+  std::string autotune(int warmup=1, int repetitions=5);
+
   /// Assemble the tensor storage, including index and value arrays.
   void assemble();
 
@@ -541,11 +572,16 @@ public:
 private:
   static std::shared_ptr<ir::Module> getHelperFunctions(
       const Format& format, Datatype ctype, const std::vector<int>& dimensions);
-  static std::shared_ptr<ir::Module> getComputeKernel(const IndexStmt stmt);
-  static void cacheComputeKernel(const IndexStmt stmt, 
+  static std::shared_ptr<ir::Module> getComputeKernel(const IndexStmt stmt,
+                                                      bool assembleWhileCompute);
+  static void cacheComputeKernel(const IndexStmt stmt,
+                                 bool assembleWhileCompute,
                                  const std::shared_ptr<ir::Module> kernel);
 
   /* --- Compiler Methods --- */
+  void compileAssignment();
+  void waitForPendingCompile();
+
   bool neverPacked();
 
   void unsetNeverPacked();
@@ -579,17 +615,26 @@ private:
   struct Content;
   std::shared_ptr<Content> content;
 
+  /// Pack and iterate functions, keyed by the format, type and dimensions
+  /// they were generated for. Entries are futures so that threads that need
+  /// the same functions wait for the one thread that generates them.
   typedef std::vector<std::tuple<Format,
                                  Datatype,
                                  std::vector<int>,
-                                 std::shared_ptr<ir::Module>>> HelperFuncsCache;
+                                 std::shared_future<std::shared_ptr<ir::Module>>>>
+      HelperFuncsCache;
   static HelperFuncsCache helperFunctions;
   static std::mutex helperFunctionsMutex;
 
-  typedef std::vector<std::pair<IndexStmt, 
-                                std::shared_ptr<ir::Module>>> KernelsCache;
+  /// Compiled compute kernels, bucketed by a hash of the canonical form of the
+  /// statement they were compiled from. The cache holds at most
+  /// TACO_KERNEL_CACHE_CAPACITY kernels and evicts the least recently used.
+  struct KernelsCacheEntry;
+  typedef std::unordered_map<uint64_t,
+      std::vector<std::shared_ptr<KernelsCacheEntry>>> KernelsCache;
   static KernelsCache computeKernels;
-  static std::mutex computeKernelsMutex;
+  static size_t numComputeKernels;
+  static std::shared_timed_mutex computeKernelsMutex;
   std::vector<FunctionInterface> functionInterfaces;
   
 };
@@ -768,7 +813,12 @@ enum class FileType {
   ttx,
 
   /// .rb  - The rutherford-boeing sparse matrix format.
-  rb
+  rb,
+
+  /// .tbin - The taco binary tensor format.  It stores the packed index and
+  ///         value arrays of a tensor, which are memory mapped when read, so
+  ///         it must be read in the format it was written in.
+  tbin
 };
 
 /// Read a tensor from a file. The file format is inferred from the filename
@@ -945,6 +995,7 @@ struct TensorBase::Content {
   ir::Stmt           computeFunc;
   bool               assembleWhileCompute;
   std::shared_ptr<ir::Module> module;
+  std::shared_future<void> pendingCompile;
 
   size_t             coordinateBufferUsed;
   size_t             coordinateSize;
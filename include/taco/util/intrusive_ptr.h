@@ -1,6 +1,7 @@
 #ifndef TACO_UTIL_INTRUSIVE_PTR_H
 #define TACO_UTIL_INTRUSIVE_PTR_H
 
+#include <atomic>
 #include <iostream>
 
 namespace taco {
@@ -130,12 +131,27 @@ public:
   }
 };
 
+/// Base class for objects managed by an IntrusivePtr.  The reference count is
+/// atomic, so that pointers to the same object may be copied and released
+/// concurrently from several threads.
 template <class Data>
 class Manageable {
-  friend void acquire(const Data *data) { ++data->ref; }
-  friend void release(const Data *data) { if (--data->ref == 0) delete data; }
+public:
+  Manageable() = default;
+
+  /// A copy is a distinct object, so it starts out unreferenced.
+  Manageable(const Manageable&) {}
+  Manageable& operator=(const Manageable&) { return *this; }
+
+private:
+  friend void acquire(const Data *data) {
+    data->ref.fetch_add(1, std::memory_order_relaxed);
+  }
+  friend void release(const Data *data) {
+    if (data->ref.fetch_sub(1, std::memory_order_acq_rel) == 1) delete data;
+  }
 
-  mutable long ref = 0;
+  mutable std::atomic<long> ref{0};
 };
 
 }} // namespace simit::util
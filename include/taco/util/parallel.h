@@ -0,0 +1,72 @@
+#ifndef TACO_UTIL_PARALLEL_H
+#define TACO_UTIL_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace taco {
+namespace util {
+
+/// Returns the number of threads to use for parallel work on the host, which
+/// is the number of hardware threads (or one if that is unknown).
+inline unsigned getNumHostThreads() {
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/// Calls `body(i)` for every `i` in [0, n), spreading the calls over up to
+/// `numThreads` threads (by default one per hardware thread).  Iterations are
+/// handed out one at a time, so they may be of very different cost.  If a
+/// call throws, no further iterations are started and the exception is
+/// rethrown on the calling thread.
+inline void parallelFor(size_t n, const std::function<void(size_t)>& body,
+                        unsigned numThreads=0) {
+  if (numThreads == 0) {
+    numThreads = getNumHostThreads();
+  }
+  numThreads = (unsigned)std::min<size_t>(numThreads, n);
+  if (numThreads <= 1) {
+    for (size_t i = 0; i < n; i++) {
+      body(i);
+    }
+    return;
+  }
+
+  std::atomic<size_t> next(0);
+  std::atomic<bool> failed(false);
+  std::exception_ptr exception;
+  std::mutex exceptionMutex;
+  auto worker = [&]() {
+    for (size_t i = next++; i < n && !failed; i = next++) {
+      try {
+        body(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(exceptionMutex);
+        if (!failed.exchange(true)) {
+          exception = std::current_exception();
+        }
+      }
+    }
+  };
+
+  // The calling thread is one of the workers
+  std::vector<std::thread> threads;
+  for (unsigned t = 1; t < numThreads; t++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+}}
+#endif
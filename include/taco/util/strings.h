@@ -7,6 +7,7 @@
 #include <map>
 #include <iomanip>
 #include <limits>
+#include <cstdint>
 
 // To get the value of a compiler macro variable
 #define STRINGIFY(x) #x
@@ -82,5 +83,12 @@ std::string repeat(std::string text, size_t n);
 /// is filled with `fill`.
 std::string fill(std::string text, char fill, size_t n);
 
+/// Returns the 64-bit FNV-1a hash of the string. Unlike std::hash, the result
+/// is stable across processes and platforms, so it can be used to name files.
+uint64_t fnv1a(const std::string& str);
+
+/// Returns the 64-bit FNV-1a hash of the string as 16 hexadecimal characters.
+std::string fnv1aHex(const std::string& str);
+
 }}
 #endif
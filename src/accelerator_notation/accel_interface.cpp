@@ -90,6 +90,13 @@ std::ostream& DimArg::print(std::ostream& os) const{
   return os;
 }
 
+std::ostream& DimProduct::print(std::ostream& os) const{
+  for (size_t i = 0; i < indexVars.size(); i++) {
+    os << (i > 0 ? "*" : "") << "Dim(" << indexVars[i] << ")";
+  }
+  return os;
+}
+
 std::ostream& TensorArg::print(std::ostream& os) const{
   os << irExpr;
   return os;
@@ -12,16 +12,28 @@
 namespace taco {
 
 
+static std::vector<OpTypes> getOpPattern(IndexExpr e);
+static std::vector<OpTypes> getOpPattern(AcceleratorExpr e);
+
 #define CHECK_AND_ADD_EXPR                                \
 do {                                                      \
-    if (hasOpMatch(op, e)){                               \
+    if (getPattern(op) == pattern){                       \
         matchedPatterns.push_back(op);                    \
     }                                                     \
 } while(false)
 
 std::vector<IndexExpr> allMatchedOpPatterns(IndexExpr s, AcceleratorExpr e){
+    return allMatchedOpPatterns(s, e, nullptr);
+}
+
+std::vector<IndexExpr> allMatchedOpPatterns(IndexExpr s, AcceleratorExpr e,
+                                            OpPatternCache* cache){
 
     std::vector<IndexExpr> matchedPatterns;
+    std::vector<OpTypes> pattern = getOpPattern(e);
+    auto getPattern = [&](IndexExpr op) {
+        return cache ? cache->getOpPattern(op) : getOpPattern(op);
+    };
 
     match(s,
         std::function<void(const AddNode*, Matcher*)>([&](const AddNode* op, Matcher* ctx) {
@@ -62,6 +74,20 @@ std::vector<IndexExpr> allMatchedOpPatterns(IndexExpr s, AcceleratorExpr e){
 
 }
 
+std::vector<OpTypes> OpPatternCache::getOpPattern(IndexExpr e){
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = patterns.find(e);
+        if (it != patterns.end()){
+            return it->second;
+        }
+    }
+    std::vector<OpTypes> pattern = taco::getOpPattern(e);
+    std::lock_guard<std::mutex> lock(mutex);
+    patterns.insert({e, pattern});
+    return pattern;
+}
+
 static std::vector<OpTypes> getOpPattern(IndexExpr e){
 
     std::vector<OpTypes> opPattern;
@@ -0,0 +1,243 @@
+#include "taco/accelerator_notation/autotune.h"
+
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <sstream>
+
+#include "taco/accelerator_notation/accelerate_search.h"
+#include "taco/accelerator_notation/code_gen_dynamic_order.h"
+#include "taco/accelerator_notation/cost_model.h"
+#include "taco/error.h"
+#include "taco/util/env.h"
+#include "taco/util/strings.h"
+
+namespace taco {
+
+/// Returns up to `maxTilings` tilings of the expression's index variables
+/// for which the interface's constraints hold, starting with the largest.
+/// The others halve one tile size of the largest, which may suit the caches
+/// better.
+static std::vector<std::map<IndexVar, int>>
+getTilings(IndexExpr expr, FunctionInterface functionInterface, int maxTilings) {
+  std::vector<std::map<IndexVar, int>> tilings;
+  DynamicStmt constraints = functionInterface.getNode()->getConstraints();
+  if (!constraints.defined() || maxTilings <= 0) {
+    return tilings;
+  }
+  AcceleratorAssignment assign =
+      to<AcceleratorAssignment>(functionInterface.getNode()->getStmt());
+  ArgumentMap argumentMap = hasPreciseMatch(expr, assign.getRhs());
+  if (!argumentMap.possible) {
+    return tilings;
+  }
+
+  // The constraints are written in terms of the interface's index variables.
+  std::map<IndexVar, Dimension> domains = expr.getIndexVarDomains();
+  std::map<IndexVar, int> interfaceDims;
+  std::map<IndexVar, IndexVar> exprVars;
+  for (auto& entry : argumentMap.indexVars) {
+    if (domains.count(entry.second) && domains.at(entry.second).isFixed()) {
+      interfaceDims[entry.first] = (int) domains.at(entry.second).getSize();
+      exprVars.insert({entry.first, entry.second});
+    }
+  }
+
+  std::vector<std::map<IndexVar, int>> interfaceTilings;
+  try {
+    std::map<IndexVar, int> largest =
+        GenerateSMTCode(constraints, {}, interfaceDims, true).getTilings();
+    if (largest.empty()) {
+      return tilings;
+    }
+    interfaceTilings.push_back(largest);
+    for (auto& entry : largest) {
+      for (int size = entry.second / 2;
+           size > 0 && (int) interfaceTilings.size() < maxTilings; size /= 2) {
+        std::map<IndexVar, int> tiling = largest;
+        tiling[entry.first] = size;
+        if (GenerateSMTCode(constraints, {}, tiling, false).isSat()) {
+          interfaceTilings.push_back(tiling);
+        }
+      }
+    }
+  } catch (TacoException&) {
+    return tilings;
+  }
+
+  for (auto& interfaceTiling : interfaceTilings) {
+    std::map<IndexVar, int> tiling;
+    for (auto& entry : interfaceTiling) {
+      if (exprVars.count(entry.first)) {
+        tiling[exprVars.at(entry.first)] = entry.second;
+      }
+    }
+    if (!tiling.empty()) {
+      tilings.push_back(tiling);
+    }
+  }
+  return tilings;
+}
+
+/// Describes a tiling by its tile sizes in the order the index variables
+/// first appear in the expression, since the variables' names and identities
+/// differ between statements with the same tuning key.
+static std::string describeTiling(IndexExpr expr, const std::map<IndexVar, int>& tiling) {
+  std::vector<std::string> sizes;
+  for (auto& var : getIndexVars(expr)) {
+    sizes.push_back(tiling.count(var) ? util::toString(tiling.at(var)) : "-");
+  }
+  return util::join(sizes, "x");
+}
+
+/// Builds the schedules of getTuningCandidates, or only the one with the
+/// given description if there is one.
+static std::vector<TuningCandidate>
+getCandidates(IndexStmt stmt, const std::vector<FunctionInterface>& functionInterfaces,
+              int maxTilings, const std::string* description) {
+  std::vector<TuningCandidate> candidates;
+  auto wanted = [&](const std::string& name) {
+    return !description || description->compare(0, name.size(), name) == 0;
+  };
+  auto add = [&](const std::string& name, const std::function<IndexStmt()>& schedule) {
+    if (description && *description != name) {
+      return;
+    }
+    try {
+      candidates.push_back({name, schedule()});
+    } catch (TacoException&) {
+      // The mapping cannot be applied to this statement.
+    }
+  };
+
+  add("default", [&]() { return stmt.concretize(); });
+  if (!isa<Assignment>(stmt) || functionInterfaces.empty()) {
+    return candidates;
+  }
+
+  std::vector<AcceleratedCandidate> accelerated =
+      stmt.autoAccelerateCandidates(stmt, functionInterfaces);
+  for (size_t i = 0; i < accelerated.size(); i++) {
+    for (size_t m = 0; m < accelerated[i].mappings.size(); m++) {
+      IndexExpr expr = accelerated[i].mappings[m].first;
+      FunctionInterface functionInterface = accelerated[i].mappings[m].second;
+      std::string name = "candidate " + util::toString(i) + " mapping " +
+                         util::toString(m) + " " +
+                         functionInterface.getNode()->getFunctionName();
+      if (!wanted(name)) {
+        continue;
+      }
+      IndexStmt concrete = accelerated[i].rewrite.concretize();
+      add(name, [&]() { return concrete.accelerate(functionInterface, expr); });
+      for (auto& tiling : getTilings(expr, functionInterface, maxTilings)) {
+        add(name + " tiles " + describeTiling(expr, tiling), [&]() {
+          return concrete.tile(functionInterface, expr, tiling);
+        });
+      }
+    }
+  }
+  return candidates;
+}
+
+std::vector<TuningCandidate> getTuningCandidates(IndexStmt stmt,
+                                                 const std::vector<FunctionInterface>& functionInterfaces,
+                                                 int maxTilings) {
+  return getCandidates(stmt, functionInterfaces, maxTilings, nullptr);
+}
+
+IndexStmt getTuningCandidate(IndexStmt stmt,
+                             const std::vector<FunctionInterface>& functionInterfaces,
+                             const std::string& description, int maxTilings) {
+  std::vector<TuningCandidate> candidates =
+      getCandidates(stmt, functionInterfaces, maxTilings, &description);
+  return candidates.empty() ? IndexStmt() : candidates[0].stmt;
+}
+
+std::string getTuningKey(IndexStmt stmt,
+                         const std::vector<FunctionInterface>& functionInterfaces) {
+  std::string key = toCanonicalString(stmt);
+  for (auto& functionInterface : functionInterfaces) {
+    key += "; " + functionInterface.getNode()->getFunctionName();
+  }
+  return key;
+}
+
+TuningDatabase::TuningDatabase(const std::string& path) : path(path) {
+}
+
+TuningDatabase& TuningDatabase::getDefault() {
+  std::string path = util::getFromEnv("TACO_TUNING_DATABASE", "");
+  if (path.empty()) {
+    std::string cachedir = util::getFromEnv("TACO_KERNEL_CACHE_DIR", "");
+    if (!cachedir.empty()) {
+      path = cachedir + (cachedir.back() == '/' ? "" : "/") + "tuning.db";
+    }
+  }
+
+  // Databases are never destroyed, so references to them stay valid.
+  static std::mutex databasesMutex;
+  static std::map<std::string, std::unique_ptr<TuningDatabase>> databases;
+  std::lock_guard<std::mutex> lock(databasesMutex);
+  auto& database = databases[path];
+  if (!database) {
+    database.reset(new TuningDatabase(path));
+  }
+  return *database;
+}
+
+void TuningDatabase::load() {
+  if (loaded) {
+    return;
+  }
+  loaded = true;
+  if (path.empty()) {
+    return;
+  }
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line)) {
+    size_t separator = line.find(' ');
+    if (separator == std::string::npos) {
+      continue;
+    }
+    decisions[line.substr(0, separator)] = line.substr(separator + 1);
+  }
+}
+
+bool TuningDatabase::lookup(const std::string& key, std::string* description) {
+  std::lock_guard<std::mutex> lock(mutex);
+  load();
+  auto decision = decisions.find(util::fnv1aHex(key));
+  if (decision == decisions.end()) {
+    return false;
+  }
+  *description = decision->second;
+  return true;
+}
+
+void TuningDatabase::store(const std::string& key, const std::string& description) {
+  taco_iassert(description.find('\n') == std::string::npos);
+  std::lock_guard<std::mutex> lock(mutex);
+  load();
+  std::string hash = util::fnv1aHex(key);
+  decisions[hash] = description;
+  if (!path.empty()) {
+    std::ofstream file(path, std::ios::app);
+    file << hash << " " << description << std::endl;
+  }
+}
+
+void TuningDatabase::clear() {
+  std::lock_guard<std::mutex> lock(mutex);
+  decisions.clear();
+  loaded = true;
+  if (!path.empty()) {
+    std::ofstream file(path, std::ios::trunc);
+  }
+}
+
+const std::string& TuningDatabase::getPath() const {
+  return path;
+}
+
+}
@@ -3,6 +3,7 @@
 #include "taco/accelerator_notation/accelerator_notation.h"
 #include "taco/accelerator_notation/code_gen_dynamic_order.h"
 #include "taco/util/env.h"
+#include "taco/util/name_generator.h"
 #include <fstream>
 #include <cstdio>
 #include <iostream>
@@ -11,6 +12,9 @@
 #include <string>
 #include <array>
 #include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
 
 
 using namespace std;
@@ -80,12 +84,486 @@ static std::map<IndexVar, int> compare(std::map<IndexVar, int> a, std::map<Index
     return b;
 }
 
+namespace {
+
+// The in-process solver answers tiling queries by branch and bound over the
+// (small) integer domains of the tile sizes.  Constraints are first lowered to
+// terms with all forall/exists quantifiers unrolled, and are then evaluated
+// over intervals so that partial assignments that cannot satisfy them are
+// pruned early.
+
+struct Term;
+typedef std::shared_ptr<const Term> TermPtr;
+
+struct Term {
+    enum Kind {Literal, Variable, Add, Sub, Mul, Div, Mod, Equal, NotEqual,
+               Greater, Less, Leq, Geq, And, Or};
+
+    Term(Kind kind, long long value, std::vector<TermPtr> operands={})
+        : kind(kind), value(value), operands(operands) {}
+
+    Kind kind;
+    long long value;  // The literal value, or the number of the variable
+    std::vector<TermPtr> operands;
+};
+
+/// An integer interval [lo, hi].  Truth values are intervals too: [1,1] is
+/// true, [0,0] is false and [0,1] is unknown.
+struct Interval {
+    long long lo;
+    long long hi;
+
+    bool isPoint() const {
+        return lo == hi;
+    }
+};
+
+// Bounds are clamped well inside the range of long long so that adding or
+// multiplying two clamped bounds cannot overflow before it is clamped again.
+const long long unbounded = 1LL << 61;
+
+long long clamp(long double value) {
+    if (value > unbounded) return unbounded;
+    if (value < -unbounded) return -unbounded;
+    return (long long) value;
+}
+
+// z3 integer division and modulo are Euclidean: the remainder is never
+// negative.
+long long euclideanDiv(long long a, long long b) {
+    long long q = a / b;
+    if (a % b < 0) {
+        q = (b > 0) ? q - 1 : q + 1;
+    }
+    return q;
+}
+
+long long euclideanMod(long long a, long long b) {
+    long long r = a % b;
+    return (r < 0) ? r + std::llabs(b) : r;
+}
+
+Interval fromCorners(std::vector<long double> corners) {
+    auto bounds = std::minmax_element(corners.begin(), corners.end());
+    return {clamp(*bounds.first), clamp(*bounds.second)};
+}
+
+Interval truth(bool isTrue, bool isFalse) {
+    return {isTrue ? 1 : 0, isFalse ? 0 : 1};
+}
+
+/// Lowers a DynamicStmt to a term over the variables in `variables`.
+class ConstraintLowerer : public DynamicNotationVisitorStrict {
+public:
+    ConstraintLowerer(const std::map<DynamicOrder, std::vector<IndexVar>>& dynamicOrderToVar,
+                      const std::map<std::string, int>& variables)
+        : dynamicOrderToVar(dynamicOrderToVar), variables(variables) {}
+
+    /// Returns the lowered term, or nullptr if the statement uses constructs
+    /// the in-process solver does not support.
+    TermPtr lower(DynamicStmt stmt) {
+        stmt.accept(this);
+        return supported ? term : nullptr;
+    }
+
+    using DynamicNotationVisitorStrict::visit;
+
+private:
+    std::map<DynamicOrder, std::vector<IndexVar>> dynamicOrderToVar;
+    std::map<std::string, int> variables;
+    std::map<DynamicIndexIterator, int> curIterator;
+    TermPtr term;
+    bool supported = true;
+
+    TermPtr lower(DynamicExpr expr) {
+        expr.accept(this);
+        return term;
+    }
+
+    TermPtr lowerStmt(DynamicStmt stmt) {
+        stmt.accept(this);
+        return term;
+    }
+
+    void literal(long long value) {
+        term = std::make_shared<Term>(Term::Literal, value);
+    }
+
+    void variable(const std::string& name) {
+        if (!variables.count(name)) {
+            supported = false;
+            literal(0);
+            return;
+        }
+        term = std::make_shared<Term>(Term::Variable, variables.at(name));
+    }
+
+    void binary(Term::Kind kind, DynamicExpr a, DynamicExpr b) {
+        TermPtr lhs = lower(a);
+        TermPtr rhs = lower(b);
+        term = std::make_shared<Term>(kind, 0, std::vector<TermPtr>({lhs, rhs}));
+    }
+
+    void quantifier(Term::Kind kind, DynamicIndexIterator it, DynamicStmt stmt) {
+        if (curIterator.count(it)){
+            taco_uerror << "Using the same iterator twice";
+        }
+        std::vector<TermPtr> conditions;
+        curIterator[it] = 0;
+        std::vector<IndexVar> indexVars = dynamicOrderToVar[it.getDynamicOrder()];
+        for (size_t i = 0; i < indexVars.size(); i++){
+            conditions.push_back(lowerStmt(stmt));
+            curIterator[it]++;
+        }
+        curIterator.erase(it);
+        term = std::make_shared<Term>(kind, 0, conditions);
+    }
+
+    void visit(const DynamicIndexIteratorNode* op) {
+        taco_uassert(curIterator.count(DynamicIndexIterator(op)));
+        literal(curIterator[DynamicIndexIterator(op)]);
+    }
+    void visit(const DynamicIndexAccessNode* op) {
+        taco_uassert(curIterator.count(op->it));
+        taco_uassert(dynamicOrderToVar.count(op->it.getDynamicOrder()));
+        std::vector<IndexVar> indices = dynamicOrderToVar[op->it.getDynamicOrder()];
+        variable(indices[curIterator[op->it]].getName());
+    }
+    void visit(const DynamicLiteralNode* op) {
+        literal(op->num);
+    }
+    void visit(const DynamicIndexLenNode* op) {
+        taco_uassert(dynamicOrderToVar.count(op->dynamicOrder));
+        literal(dynamicOrderToVar[op->dynamicOrder].size());
+    }
+    void visit(const DynamicIndexMulInternalNode*) {
+        supported = false;
+        literal(0);
+    }
+    void visit(const DynamicAddNode* op) {
+        binary(Term::Add, op->a, op->b);
+    }
+    void visit(const DynamicSubNode* op) {
+        binary(Term::Sub, op->a, op->b);
+    }
+    void visit(const DynamicMulNode* op) {
+        binary(Term::Mul, op->a, op->b);
+    }
+    void visit(const DynamicDivNode* op) {
+        binary(Term::Div, op->a, op->b);
+    }
+    void visit(const DynamicModNode* op) {
+        binary(Term::Mod, op->a, op->b);
+    }
+    void visit(const DynamicIndexVarNode* op) {
+        variable(op->i.getName());
+    }
+    void visit(const DynamicEqualNode* op) {
+        binary(Term::Equal, op->a, op->b);
+    }
+    void visit(const DynamicNotEqualNode* op) {
+        binary(Term::NotEqual, op->a, op->b);
+    }
+    void visit(const DynamicGreaterNode* op) {
+        binary(Term::Greater, op->a, op->b);
+    }
+    void visit(const DynamicLessNode* op) {
+        binary(Term::Less, op->a, op->b);
+    }
+    void visit(const DynamicLeqNode* op) {
+        binary(Term::Leq, op->a, op->b);
+    }
+    void visit(const DynamicGeqNode* op) {
+        binary(Term::Geq, op->a, op->b);
+    }
+    void visit(const DynamicForallNode* op) {
+        quantifier(Term::And, op->it, op->stmt);
+    }
+    void visit(const DynamicExistsNode* op) {
+        quantifier(Term::Or, op->it, op->stmt);
+    }
+    void visit(const DynamicAndNode* op) {
+        TermPtr lhs = lowerStmt(op->a);
+        TermPtr rhs = lowerStmt(op->b);
+        term = std::make_shared<Term>(Term::And, 0, std::vector<TermPtr>({lhs, rhs}));
+    }
+    void visit(const DynamicOrNode* op) {
+        TermPtr lhs = lowerStmt(op->a);
+        TermPtr rhs = lowerStmt(op->b);
+        term = std::make_shared<Term>(Term::Or, 0, std::vector<TermPtr>({lhs, rhs}));
+    }
+};
+
+/// Evaluates a term over intervals of variable values.  Sets `undefined` if
+/// the term divides by zero, which z3 leaves unspecified.
+Interval evaluate(const Term& term, const std::vector<Interval>& domains,
+                  bool* undefined) {
+    switch (term.kind) {
+        case Term::Literal:
+            return {term.value, term.value};
+        case Term::Variable:
+            return domains[term.value];
+        case Term::And:
+        case Term::Or: {
+            bool isAnd = term.kind == Term::And;
+            Interval result = isAnd ? Interval{1, 1} : Interval{0, 0};
+            for (auto& operand : term.operands) {
+                Interval value = evaluate(*operand, domains, undefined);
+                if (isAnd) {
+                    result = {std::min(result.lo, value.lo), std::min(result.hi, value.hi)};
+                    if (result.hi == 0) break;
+                } else {
+                    result = {std::max(result.lo, value.lo), std::max(result.hi, value.hi)};
+                    if (result.lo == 1) break;
+                }
+            }
+            return result;
+        }
+        default:
+            break;
+    }
+
+    Interval a = evaluate(*term.operands[0], domains, undefined);
+    Interval b = evaluate(*term.operands[1], domains, undefined);
+    switch (term.kind) {
+        case Term::Add:
+            return {clamp((long double) a.lo + b.lo), clamp((long double) a.hi + b.hi)};
+        case Term::Sub:
+            return {clamp((long double) a.lo - b.hi), clamp((long double) a.hi - b.lo)};
+        case Term::Mul:
+            return fromCorners({(long double) a.lo * b.lo, (long double) a.lo * b.hi,
+                                (long double) a.hi * b.lo, (long double) a.hi * b.hi});
+        case Term::Div:
+            if (b.isPoint() && b.lo == 0) {
+                *undefined = true;
+                return {-unbounded, unbounded};
+            }
+            if (b.lo <= 0 && b.hi >= 0) {
+                return {-unbounded, unbounded};
+            }
+            // Euclidean division is monotone in each operand when the divisor
+            // does not change sign, so its extremes are at the corners.
+            return fromCorners({(long double) euclideanDiv(a.lo, b.lo),
+                                (long double) euclideanDiv(a.lo, b.hi),
+                                (long double) euclideanDiv(a.hi, b.lo),
+                                (long double) euclideanDiv(a.hi, b.hi)});
+        case Term::Mod: {
+            if (b.isPoint() && b.lo == 0) {
+                *undefined = true;
+                return {-unbounded, unbounded};
+            }
+            if (b.lo <= 0 && b.hi >= 0) {
+                return {-unbounded, unbounded};
+            }
+            if (b.isPoint()) {
+                long long m = std::llabs(b.lo);
+                long long block = euclideanDiv(a.lo, m);
+                if (euclideanDiv(a.hi, m) == block) {
+                    return {a.lo - block * m, a.hi - block * m};
+                }
+                return {0, m - 1};
+            }
+            return {0, std::max(std::llabs(b.lo), std::llabs(b.hi)) - 1};
+        }
+        case Term::Equal:
+            return truth(a.isPoint() && b.isPoint() && a.lo == b.lo,
+                         a.hi < b.lo || b.hi < a.lo);
+        case Term::NotEqual:
+            return truth(a.hi < b.lo || b.hi < a.lo,
+                         a.isPoint() && b.isPoint() && a.lo == b.lo);
+        case Term::Greater:
+            return truth(a.lo > b.hi, a.hi <= b.lo);
+        case Term::Less:
+            return truth(a.hi < b.lo, a.lo >= b.hi);
+        case Term::Leq:
+            return truth(a.hi <= b.lo, a.lo > b.hi);
+        case Term::Geq:
+            return truth(a.lo >= b.hi, a.hi < b.lo);
+        default:
+            taco_ierror;
+            return {0, 1};
+    }
+}
+
+/// Finds the assignment of values from `domains` that satisfies a constraint
+/// and has the largest product, trying larger values first.
+class TilingSearch {
+public:
+    TilingSearch(TermPtr constraint, std::vector<Interval> domains)
+        : constraint(constraint), domains(domains), upper(domains.size()+1, 1) {
+        for (size_t i = domains.size(); i > 0; i--) {
+            upper[i-1] = upper[i] * domains[i-1].hi;
+        }
+    }
+
+    /// Returns false if the search gave up, either because it took more than
+    /// `budget` steps or because the constraint divides by zero.
+    bool run(size_t budget) {
+        this->budget = budget;
+        for (auto& domain : domains) {
+            if (domain.lo > domain.hi) {
+                return true;
+            }
+        }
+        search(0, 1);
+        return !aborted;
+    }
+
+    bool sat = false;
+    std::vector<long long> best;
+
+private:
+    TermPtr constraint;
+    std::vector<Interval> domains;
+    std::vector<long double> upper;  // Products of the remaining upper bounds
+    long double bestProduct = 0;
+    size_t budget = 0;
+    size_t steps = 0;
+    bool aborted = false;
+
+    void search(size_t var, long double product) {
+        if (++steps > budget) {
+            aborted = true;
+            return;
+        }
+        bool undefined = false;
+        Interval value = evaluate(*constraint, domains, &undefined);
+        if (undefined) {
+            aborted = true;
+            return;
+        }
+        if (value.hi == 0) {
+            return;
+        }
+        if (var == domains.size()) {
+            taco_iassert(value.isPoint());
+            if (!sat || product > bestProduct) {
+                sat = true;
+                bestProduct = product;
+                best.clear();
+                for (auto& domain : domains) {
+                    best.push_back(domain.lo);
+                }
+            }
+            return;
+        }
+
+        Interval domain = domains[var];
+        for (long long v = domain.hi; v >= domain.lo && !aborted; v--) {
+            if (sat && product * v * upper[var+1] <= bestProduct) {
+                break;
+            }
+            domains[var] = {v, v};
+            search(var+1, product * v);
+        }
+        domains[var] = domain;
+    }
+};
+
+// The number of search steps after which the in-process solver gives up and
+// the query is sent to z3.
+const size_t searchBudget = 1 << 22;
+
+std::mutex solutionsMutex;
+
+} // anonymous namespace
+
 std::map<IndexVar, int> GenerateSMTCode::getTilings(){
     std::map<IndexVar, int> tilings;
-    if (!isSat()){
-        return tilings;
+    Solution solution = solve();
+    for (auto& entry : solution.tiling){
+        taco_uassert(nameToVar.count(entry.first));
+        tilings[nameToVar[entry.first]] = entry.second;
+    }
+    return tilings;
+}
+
+bool GenerateSMTCode::isSat(){
+    return solve().sat;
+}
+
+GenerateSMTCode::Solution GenerateSMTCode::solve(){
+    static std::map<std::string, Solution> solutions;
+
+    // The query captures the constraint together with the variable bounds,
+    // so it identifies the answer.
+    std::string query = generatePythonCode();
+    {
+        std::lock_guard<std::mutex> lock(solutionsMutex);
+        if (solutions.count(query)){
+            return solutions.at(query);
+        }
+    }
+
+    Solution solution;
+    if (util::getFromEnv("TACO_SMT_SOLVER", "native") == "python" ||
+        !solveNative(&solution)){
+        solution = solvePython();
+    }
+
+    std::lock_guard<std::mutex> lock(solutionsMutex);
+    solutions.insert({query, solution});
+    return solution;
+}
+
+bool GenerateSMTCode::solveNative(Solution* solution){
+    // Mirror the variable declarations of the Python query: the bound of each
+    // name comes from its first declaration.
+    std::map<std::string, int> dims;
+    for (auto entry : indexVarName){
+        if (!dims.count(entry.second)){
+            dims[entry.second] = varToDim[entry.first];
+        }
+    }
+    for (auto entry : dynamicOrderToVar){
+        for (auto var : entry.second){
+            if (!dims.count(var.getName())){
+                taco_uassert(varToDim.count(var));
+                dims[var.getName()] = varToDim[var];
+            }
+        }
+    }
+
+    std::map<std::string, int> variables;
+    std::vector<std::string> names;
+    std::vector<Interval> domains;
+    for (auto& entry : dims){
+        variables[entry.first] = (int) names.size();
+        names.push_back(entry.first);
+        // Every variable is positive, and below (tile) or equal to its
+        // dimension
+        long long dim = entry.second;
+        domains.push_back(tile ? Interval{1, dim - 1} : Interval{std::max(1LL, dim), dim});
     }
+
+    TermPtr constraint = ConstraintLowerer(dynamicOrderToVar, variables).lower(stmtLower);
+    if (!constraint){
+        return false;
+    }
+
+    TilingSearch search(constraint, domains);
+    if (!search.run(searchBudget)){
+        return false;
+    }
+    solution->sat = search.sat;
+    solution->tiling.clear();
+    if (search.sat){
+        for (size_t i = 0; i < names.size(); i++){
+            solution->tiling[names[i]] = (int) search.best[i];
+        }
+    }
+    return true;
+}
+
+GenerateSMTCode::Solution GenerateSMTCode::solvePython(){
+    Solution solution;
     std::string SMTRetrun = runSMT();
+    solution.sat = SMTRetrun.substr(0,3) == "sat";
+    if (!solution.sat){
+        return solution;
+    }
+
+    std::map<IndexVar, int> tilings;
     std::vector<std::string> potentialTilings = split(SMTRetrun, '\n');
     bool first = true; 
     for (auto potentialTiling : potentialTilings){
@@ -109,16 +587,10 @@ std::map<IndexVar, int> GenerateSMTCode::getTilings(){
             tilings = compare(tilings, curTiling);
         }
     }
-    return tilings;
-}
-
-bool GenerateSMTCode::isSat(){
-    std::string result = runSMT();
-    if (result.substr(0,3) == "sat"){
-        return true;
+    for (auto& entry : tilings){
+        solution.tiling[entry.first.getName()] = entry.second;
     }
-    return false; 
-
+    return solution;
 }
 
 // GROSS!!!!!
@@ -130,15 +602,17 @@ std::string GenerateSMTCode::runSMT(){
     // auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
     // std::cout << "Time taken by function: "
     //      << duration.count() << " us" << std::endl;
-    //gets generated in build/bin
-    ofstream SMTPython("SMTpython.py");
+    //gets generated in build/bin, with a unique name since queries may be
+    //run from several threads
+    std::string fileName = util::uniqueName("SMTpython") + ".py";
+    ofstream SMTPython(fileName);
     SMTPython << pythonCode;
     SMTPython.close();
     // start = std::chrono::high_resolution_clock::now();
-    std::string result =  exec("python3 SMTpython.py");
+    std::string result =  exec(("python3 " + fileName).c_str());
+    std::remove(fileName.c_str());
     // stop = std::chrono::high_resolution_clock::now();
     // duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
-    // system("rm -rf SMTpython.py");
     return result; 
 }
 
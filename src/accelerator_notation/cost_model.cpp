@@ -0,0 +1,174 @@
+#include "taco/accelerator_notation/cost_model.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "taco/index_notation/index_notation_nodes.h"
+#include "taco/index_notation/index_notation_visitor.h"
+#include "taco/accelerator_notation/interface_schedular.h"
+#include "taco/error.h"
+
+namespace taco {
+
+namespace {
+
+/// Counts the operations of an expression or statement, and the sizes of the
+/// index variables and tensors it accesses.
+struct WorkCounter : public IndexNotationVisitor {
+  using IndexNotationVisitor::visit;
+
+  size_t ops = 0;
+  std::map<IndexVar, size_t> domains;
+  std::map<TensorVar, double> tensorBytes;
+
+  Work getWork() const {
+    double iterations = 1;
+    for (auto& domain : domains) {
+      iterations *= domain.second;
+    }
+    Work work;
+    work.flops = ops * iterations;
+    for (auto& tensor : tensorBytes) {
+      work.bytes += tensor.second;
+    }
+    return work;
+  }
+
+  void visit(const AccessNode* node) {
+    Type type = node->tensorVar.getType();
+    double elements = 1;
+    for (size_t i = 0; i < node->indexVars.size(); i++) {
+      Dimension dimension = type.getShape().getDimension(i);
+      size_t size = dimension.isFixed() ? dimension.getSize() : 1;
+      domains[node->indexVars[i]] = std::max(domains[node->indexVars[i]], size);
+      elements *= size;
+    }
+    tensorBytes[node->tensorVar] = elements * type.getDataType().getNumBytes();
+  }
+
+  void visit(const UnaryExprNode* node) {
+    ops++;
+    IndexNotationVisitor::visit(node);
+  }
+
+  void visit(const BinaryExprNode* node) {
+    ops++;
+    IndexNotationVisitor::visit(node);
+  }
+
+  void visit(const ReductionNode* node) {
+    ops++;
+    IndexNotationVisitor::visit(node);
+  }
+
+  void visit(const CallNode* node) {
+    ops++;
+    IndexNotationVisitor::visit(node);
+  }
+
+  void visit(const CallIntrinsicNode* node) {
+    ops++;
+    IndexNotationVisitor::visit(node);
+  }
+
+  void visit(const AssignmentNode* node) {
+    if (node->op.defined()) {
+      ops++;
+    }
+    node->lhs.accept(this);
+    node->rhs.accept(this);
+  }
+};
+
+double getTime(const Work& work, double flopRate, double bandwidth) {
+  return std::max(work.flops / flopRate, work.bytes / bandwidth);
+}
+
+} // anonymous namespace
+
+Work getWork(IndexExpr expr) {
+  WorkCounter counter;
+  expr.accept(&counter);
+  return counter.getWork();
+}
+
+Work getWork(IndexStmt stmt) {
+  WorkCounter counter;
+  stmt.accept(&counter);
+  return counter.getWork();
+}
+
+AnalyticalCostModel::AnalyticalCostModel(double flopRate, double interfaceFlopRate,
+                                         double bandwidth, double callOverhead)
+    : flopRate(flopRate), interfaceFlopRate(interfaceFlopRate),
+      bandwidth(bandwidth), callOverhead(callOverhead) {
+  taco_uassert(flopRate > 0 && interfaceFlopRate > 0 && bandwidth > 0)
+      << "Cost model rates must be positive";
+}
+
+void AnalyticalCostModel::calibrate(const std::string& functionName, double flopRate) {
+  taco_uassert(flopRate > 0) << "Calibrated rate of " << functionName
+                             << " must be positive";
+  calibration[functionName] = flopRate;
+}
+
+void AnalyticalCostModel::loadCalibration(const std::string& path) {
+  std::ifstream file(path);
+  taco_uassert(file.is_open()) << "Could not open calibration table " << path;
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream stream(line);
+    std::string functionName;
+    double rate;
+    if (!(stream >> functionName) || functionName[0] == '#') {
+      continue;
+    }
+    taco_uassert(bool(stream >> rate)) << "Malformed line in calibration table "
+                                       << path << ": " << line;
+    calibrate(functionName, rate);
+  }
+}
+
+double AnalyticalCostModel::getFlopRate(const std::string& functionName) const {
+  return calibration.count(functionName) ? calibration.at(functionName)
+                                         : interfaceFlopRate;
+}
+
+double AnalyticalCostModel::estimate(const AcceleratedCandidate& candidate) const {
+  // The mapped subexpressions are accesses to temporaries in the candidate,
+  // so what is left of its statement is the generated code.
+  double time = getTime(getWork(candidate.stmt), flopRate, bandwidth);
+  for (auto& mapping : candidate.mappings) {
+    std::string functionName = mapping.second.getNode()->getFunctionName();
+    time += getTime(getWork(mapping.first), getFlopRate(functionName), bandwidth);
+    time += callOverhead;
+  }
+  return time;
+}
+
+AcceleratedCandidate selectAccelerated(IndexStmt stmt,
+                                       const std::vector<FunctionInterface>& functionInterfaces,
+                                       const CostModel& costModel,
+                                       AutoAccelerateStats* stats) {
+  std::vector<AcceleratedCandidate> candidates =
+      stmt.autoAccelerateCandidates(stmt, functionInterfaces, stats);
+  taco_iassert(!candidates.empty());
+
+  Piles piles([](const Pile& a, const Pile& b) {
+    if (a.getCost() != b.getCost()) {
+      return a.getCost() > b.getCost();
+    }
+    return a.getId() > b.getId();
+  });
+  for (size_t i = 0; i < candidates.size(); i++) {
+    std::vector<FunctionInterface> functionInterfaces;
+    for (auto& mapping : candidates[i].mappings) {
+      functionInterfaces.push_back(mapping.second);
+    }
+    piles.feed(Pile(candidates[i].stmt, functionInterfaces,
+                    costModel.estimate(candidates[i]), i));
+  }
+  return candidates[piles.get().getId()];
+}
+
+}
@@ -194,6 +194,15 @@ string CodeGen::printContextDeclAndInit(map<Expr, string, ExprCompare> varMap,
   return ret.str();
 }
 
+/// Index arrays are declared as int arrays unless they are of wider types.
+static string printIndexType(Datatype type) {
+  switch (type.getKind()) {
+    case Datatype::Int64:  return "int64_t";
+    case Datatype::UInt64: return "uint64_t";
+    default:               return "int";
+  }
+}
+
 string CodeGen::printTensorProperty(string varname, const GetProperty* op, bool is_ptr) {
   stringstream ret;
   string star = is_ptr ? "*" : "";
@@ -208,7 +217,7 @@ string CodeGen::printTensorProperty(string varname, const GetProperty* op, bool
     ret << " " << varname;
     return ret.str();
   } else if (op->property == TensorProperty::ValuesSize) {
-    ret << "int" << star << " " << varname;
+    ret << "int64_t" << star << " " << varname;
     return ret.str();
   }
 
@@ -222,7 +231,7 @@ string CodeGen::printTensorProperty(string varname, const GetProperty* op, bool
     ret << tp << " " << varname;
   } else {
     taco_iassert(op->property == TensorProperty::Indices);
-    tp = "int*" + star;
+    tp = printIndexType(op->type) + "*" + star;
     ret << tp << " " << varname;
   }
 
@@ -242,7 +251,7 @@ string CodeGen::unpackTensorProperty(string varname, const GetProperty* op,
     ret << tensor->name << "->vals);\n";
     return ret.str();
   } else if (op->property == TensorProperty::ValuesSize) {
-    ret << "int " << varname << " = " << tensor->name << "->vals_size;\n";
+    ret << "int64_t " << varname << " = " << tensor->name << "->vals_size;\n";
     return ret.str();
   } else if (op->property == TensorProperty::FillValue) {
     ret << printType(tensor->type, false) << " " << varname << " = ";
@@ -261,10 +270,10 @@ string CodeGen::unpackTensorProperty(string varname, const GetProperty* op,
         << "->dimensions[" << op->mode << "]);\n";
   } else {
     taco_iassert(op->property == TensorProperty::Indices);
-    tp = "int*";
+    tp = printIndexType(op->type) + "*";
     auto nm = op->index;
     ret << tp << " " << restrictKeyword() << " " << varname << " = ";
-    ret << "(int*)(" << tensor->name << "->indices[" << op->mode;
+    ret << "(" << tp << ")(" << tensor->name << "->indices[" << op->mode;
     ret << "][" << nm << "]);\n";
   }
 
@@ -64,7 +64,7 @@ const string cHeaders =
   "  uint8_t***   indices;       // tensor index data (per mode)\n"
   "  uint8_t*     vals;          // tensor values\n"
   "  uint8_t*     fill_value;    // tensor fill value\n"
-  "  int32_t      vals_size;     // values array size\n"
+  "  int64_t      vals_size;     // values array size\n"
   "} taco_tensor_t;\n"
   "#endif\n"
   // "#if !_OPENMP\n"
@@ -138,6 +138,176 @@ const string cHeaders =
   "  }\n"
   "  return lowerBound;\n"
   "}\n"
+  // Bitmap modes mark coordinate i with bit (i % 64) of a 64-bit word.
+  "bool taco_bitmapTest(uint64_t word, int64_t i) {\n"
+  "  return (word >> (i & 63)) & 1;\n"
+  "}\n"
+  "uint64_t taco_bitmapSet(uint64_t word, int64_t i) {\n"
+  "  return word | ((uint64_t)1 << (i & 63));\n"
+  "}\n"
+  "int32_t taco_bitmapRank(uint64_t word, int64_t i) {\n"
+  "  return __builtin_popcountll(word & (((uint64_t)1 << (i & 63)) - 1));\n"
+  "}\n"
+  "int32_t taco_bitmapCount(uint64_t word) {\n"
+  "  return __builtin_popcountll(word);\n"
+  "}\n"
+  "int32_t taco_bitmapFirst(uint64_t word) {\n"
+  "  return __builtin_ctzll(word);\n"
+  "}\n"
+  "uint64_t taco_bitmapNext(uint64_t word) {\n"
+  "  return word & (word - 1);\n"
+  "}\n"
+  // The SIMD kernels below have a variant for every instruction set, compiled
+  // with target attributes so that the module itself does not require any of
+  // them.  The variant that the processor supports is picked by CPUID when the
+  // module is loaded.  Every variant returns how far it got, and the kernel
+  // finishes the elements that do not fill a vector one at a time.
+  "#if defined(__GNUC__) && defined(__x86_64__)\n"
+  "#define TACO_SIMD_DISPATCH\n"
+  "__attribute__((target(\"avx512f\")))\n"
+  "static int taco_blockAdvanceAVX512(int *array, int curr, int arrayEnd, int target) {\n"
+  "  __m512i targets = _mm512_set1_epi32(target);\n"
+  "  while (curr + 16 <= arrayEnd) {\n"
+  "    __m512i block = _mm512_loadu_si512((const void*)(array + curr));\n"
+  "    int less = (int)_mm512_cmplt_epi32_mask(block, targets);\n"
+  "    if (less != 0xffff) {\n"
+  "      return curr + __builtin_ctz(~less);\n"
+  "    }\n"
+  "    curr += 16;\n"
+  "  }\n"
+  "  return curr;\n"
+  "}\n"
+  "__attribute__((target(\"avx2\")))\n"
+  "static int taco_blockAdvanceAVX2(int *array, int curr, int arrayEnd, int target) {\n"
+  "  __m256i targets = _mm256_set1_epi32(target);\n"
+  "  while (curr + 8 <= arrayEnd) {\n"
+  "    __m256i block = _mm256_loadu_si256((const __m256i*)(array + curr));\n"
+  "    int less = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(targets, block)));\n"
+  "    if (less != 0xff) {\n"
+  "      return curr + __builtin_ctz(~less);\n"
+  "    }\n"
+  "    curr += 8;\n"
+  "  }\n"
+  "  return curr;\n"
+  "}\n"
+  "static int taco_blockAdvanceSSE(int *array, int curr, int arrayEnd, int target) {\n"
+  "  __m128i targets = _mm_set1_epi32(target);\n"
+  "  while (curr + 4 <= arrayEnd) {\n"
+  "    __m128i block = _mm_loadu_si128((const __m128i*)(array + curr));\n"
+  "    int less = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(block, targets)));\n"
+  "    if (less != 0xf) {\n"
+  "      return curr + __builtin_ctz(~less);\n"
+  "    }\n"
+  "    curr += 4;\n"
+  "  }\n"
+  "  return curr;\n"
+  "}\n"
+  "__attribute__((target(\"avx512f\")))\n"
+  "static int32_t taco_simdAddAVX512(int32_t n, float *x, float *y, float *z) {\n"
+  "  int32_t i = 0;\n"
+  "  for (; i + 16 <= n; i += 16) {\n"
+  "    _mm512_storeu_ps(z + i, _mm512_add_ps(_mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i)));\n"
+  "  }\n"
+  "  return i;\n"
+  "}\n"
+  "__attribute__((target(\"avx2\")))\n"
+  "static int32_t taco_simdAddAVX2(int32_t n, float *x, float *y, float *z) {\n"
+  "  int32_t i = 0;\n"
+  "  for (; i + 8 <= n; i += 8) {\n"
+  "    _mm256_storeu_ps(z + i, _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i)));\n"
+  "  }\n"
+  "  return i;\n"
+  "}\n"
+  "static int32_t taco_simdAddSSE(int32_t n, float *x, float *y, float *z) {\n"
+  "  int32_t i = 0;\n"
+  "  for (; i + 4 <= n; i += 4) {\n"
+  "    _mm_storeu_ps(z + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i)));\n"
+  "  }\n"
+  "  return i;\n"
+  "}\n"
+  "static int (*taco_blockAdvanceVariant)(int*, int, int, int) = taco_blockAdvanceSSE;\n"
+  "static int32_t (*taco_simdAddVariant)(int32_t, float*, float*, float*) = taco_simdAddSSE;\n"
+  "__attribute__((constructor))\n"
+  "static void taco_simdDispatch(void) {\n"
+  "  __builtin_cpu_init();\n"
+  "  if (__builtin_cpu_supports(\"avx512f\")) {\n"
+  "    taco_blockAdvanceVariant = taco_blockAdvanceAVX512;\n"
+  "    taco_simdAddVariant = taco_simdAddAVX512;\n"
+  "  } else if (__builtin_cpu_supports(\"avx2\")) {\n"
+  "    taco_blockAdvanceVariant = taco_blockAdvanceAVX2;\n"
+  "    taco_simdAddVariant = taco_simdAddAVX2;\n"
+  "  }\n"
+  "}\n"
+  "#endif\n"
+  // Increment arrayStart until array[arrayStart] >= target or arrayStart >= arrayEnd
+  // by comparing blocks of 16, 8, or 4 coordinates to the target at a time.
+  "int taco_blockAdvance(int *array, int arrayStart, int arrayEnd, int target) {\n"
+  "  int curr = arrayStart;\n"
+  "#ifdef TACO_SIMD_DISPATCH\n"
+  "  curr = taco_blockAdvanceVariant(array, curr, arrayEnd, target);\n"
+  "#endif\n"
+  "  while (curr < arrayEnd && array[curr] < target) {\n"
+  "    curr++;\n"
+  "  }\n"
+  "  return curr;\n"
+  "}\n"
+  // Stores x + y into z a vector of 16, 8, or 4 floats at a time.
+  "void taco_simdAdd(int32_t n, float *x, float *y, float *z) {\n"
+  "  int32_t i = 0;\n"
+  "#ifdef TACO_SIMD_DISPATCH\n"
+  "  i = taco_simdAddVariant(n, x, y, z);\n"
+  "#endif\n"
+  "  for (; i < n; i++) {\n"
+  "    z[i] = x[i] + y[i];\n"
+  "  }\n"
+  "}\n"
+  // Returns the first position in array[arrayStart:arrayEnd] whose coordinate is
+  // not less than target, or arrayEnd if there is none.
+  "int taco_lowerBound(int *array, int arrayStart, int arrayEnd, int target) {\n"
+  "  while (arrayStart < arrayEnd) {\n"
+  "    int mid = arrayStart + (arrayEnd - arrayStart) / 2;\n"
+  "    if (array[mid] < target) {\n"
+  "      arrayStart = mid + 1;\n"
+  "    } else {\n"
+  "      arrayEnd = mid;\n"
+  "    }\n"
+  "  }\n"
+  "  return arrayStart;\n"
+  "}\n"
+  // Returns the coordinate at which the given partition of the merge of two
+  // coordinate arrays begins, when the merge is split into numPartitions
+  // partitions of about equal length along its merge path.
+  "int taco_mergePathCoordinate(int *a, int aStart, int aEnd, int *b, int bStart, int bEnd,\n"
+  "                             int partition, int numPartitions) {\n"
+  "  int aSize = aEnd - aStart;\n"
+  "  int bSize = bEnd - bStart;\n"
+  "  int diagonal = (int)(((int64_t)(aSize + bSize) * partition) / numPartitions);\n"
+  "  if (diagonal >= aSize + bSize) {\n"
+  "    return 0x7fffffff;\n"
+  "  }\n"
+  "  int lo = diagonal > bSize ? diagonal - bSize : 0;\n"
+  "  int hi = diagonal < aSize ? diagonal : aSize;\n"
+  "  while (lo < hi) {\n"
+  "    int mid = lo + (hi - lo) / 2;\n"
+  "    if (a[aStart + mid] <= b[bStart + diagonal - mid - 1]) {\n"
+  "      lo = mid + 1;\n"
+  "    } else {\n"
+  "      hi = mid;\n"
+  "    }\n"
+  "  }\n"
+  "  int aNext = lo < aSize ? a[aStart + lo] : 0x7fffffff;\n"
+  "  int bNext = diagonal - lo < bSize ? b[bStart + diagonal - lo] : 0x7fffffff;\n"
+  "  return aNext < bNext ? aNext : bNext;\n"
+  "}\n"
+  // Split merges into several partitions per thread, so threads that finish
+  // their partitions early can take over others.
+  "int taco_mergePathPartitions() {\n"
+  "#ifdef _OPENMP\n"
+  "  return 4 * omp_get_max_threads();\n"
+  "#else\n"
+  "  return 4;\n"
+  "#endif\n"
+  "}\n"
   "taco_tensor_t* init_taco_tensor_t(int32_t order, int32_t csize,\n"
   "                                  int32_t* dimensions, int32_t* mode_ordering,\n"
   "                                  taco_mode_t* mode_types) {\n"
@@ -50,7 +50,7 @@ const string cHeaders =
   "  uint8_t***   indices;       // tensor index data (per mode)\n"
   "  uint8_t*     vals;          // tensor values\n"
   "  uint8_t*     fill_value;    // tensor fill value\n"
-  "  int32_t      vals_size;     // values array size\n"
+  "  int64_t      vals_size;     // values array size\n"
   "} taco_tensor_t;\n"
   "#endif\n"
   "#endif\n\n"; // // https://stackoverflow.com/questions/14038589/what-is-the-canonical-way-to-check-for-errors-using-the-cuda-runtime-api
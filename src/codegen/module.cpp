@@ -2,8 +2,12 @@
 
 #include <iostream>
 #include <fstream>
+#include <mutex>
+#include <cerrno>
+#include <cstdio>
 #include <dlfcn.h>
 #include <unistd.h>
+#include <sys/stat.h>
 #if USE_OPENMP
 #include <omp.h>
 #endif
@@ -29,12 +33,22 @@ std::default_random_engine Module::gen = std::default_random_engine();
 std::uniform_int_distribution<int> Module::randint =
     std::uniform_int_distribution<int>(0, chars.length() - 1);
 
+// Modules may be created concurrently, e.g. by background compilations, so
+// the shared random generator and temporary directory must be guarded.
+static std::mutex jitNamesMutex;
+
+Module::~Module() {
+  waitForOptimization();
+}
+
 void Module::setJITTmpdir() {
+  std::lock_guard<std::mutex> lock(jitNamesMutex);
   tmpdir = util::getTmpdir();
   // cout << tmpdir << endl;
 }
 
 void Module::setJITLibname() {
+  std::lock_guard<std::mutex> lock(jitNamesMutex);
   libname.resize(12);
   for (int i=0; i<12; i++)
     libname[i] = chars[randint(gen)];
@@ -112,11 +126,14 @@ void writeShims(vector<Stmt> funcs, string path, string prefix) {
   shims_file.close();
 }
 
+string getLibraryPath(string prefix, bool optimize) {
+  return prefix + (optimize ? "" : "_O0") + ".so";
+}
+
 } // anonymous namespace
 
-string Module::compile() {
-  string prefix = tmpdir+libname;
-  string fullpath = prefix + ".so";
+string Module::getCompileCommand(string prefix, bool optimize) const {
+  string fullpath = getLibraryPath(prefix, optimize);
   
   string cc;
   string cflags;
@@ -139,7 +156,12 @@ string Module::compile() {
     // Otherwise, use the standard set of optimizing flags.
     string defaultFlags = "-O3 -ffast-math -std=c99";
 #endif
-    cflags = util::getFromEnv("TACO_CFLAGS", defaultFlags) + " -shared -fPIC";
+    cflags = util::getFromEnv("TACO_CFLAGS", defaultFlags);
+    if (!optimize) {
+      // The last optimization level on the command line wins
+      cflags += " -O0";
+    }
+    cflags += " -shared -fPIC";
 #if USE_OPENMP
     cflags += " -fopenmp";
 #endif
@@ -147,7 +169,6 @@ string Module::compile() {
     shims_file = "";
   }
 
-  
   string cmd = cc + " " + cflags + " " +
     prefix + file_ending + " " + shims_file + " " + 
     "-o " + fullpath + " -lm";
@@ -211,7 +232,6 @@ char const *ret = getenv("PATH_TO_MOSAIC_ARTIFACT");
     cmd +=  " -I/usr/include/mkl"
              " -I" + path_to_artifact + "/tensor_algebra_systems_lib/cuda-wrappers/"
              " -I" + path_to_artifact + "/tensor_algebra_systems_lib/mkl/"
-            " -mavx2"
              " -I/opt/nvidia/hpc_sdk/Linux_x86_64/22.9/math_libs/11.7/targets/x86_64-linux/include/"
             " -I/usr/local/cuda-11.8/targets/x86_64-linux/include/"
            " -I" + path_to_artifact + "/tensor_algebra_systems_lib/tblis/include"
@@ -227,6 +247,20 @@ char const *ret = getenv("PATH_TO_MOSAIC_ARTIFACT");
            " -Wl,--no-as-needed -lmkl_intel_lp64 -lmkl_sequential -lmkl_avx512 -lmkl_core -lpthread -lm -ldl";
   }
 
+  return cmd;
+}
+
+string Module::compile() {
+  // The source files are about to be rewritten, so a background optimization
+  // of the previous source must not be running
+  waitForOptimization();
+
+  string prefix = tmpdir+libname;
+  bool optimize = target.compileTier == Target::Optimized ||
+                  should_use_CUDA_codegen();
+  string fullpath = getLibraryPath(prefix, optimize);
+  string cmd = getCompileCommand(prefix, optimize);
+
   // cmd += " -lblas";
     
   // open the output file & write out the source
@@ -241,14 +275,156 @@ char const *ret = getenv("PATH_TO_MOSAIC_ARTIFACT");
   taco_uassert(err == 0) << "Compilation command failed:\n" << cmd
     << "\nreturned " << err;
 
+  loadLibrary(fullpath);
+
+  if (optimize) {
+    storeInCache(fullpath);
+  }
+  else if (target.compileTier == Target::Tiered) {
+    optimization = std::async(std::launch::async, &Module::optimize, this,
+                              prefix);
+  }
+  return fullpath;
+}
+
+void Module::loadLibrary(string fullpath) {
+  std::lock_guard<std::mutex> lock(libHandleMutex);
+
   // use dlsym() to open the compiled library
   if (lib_handle) {
     dlclose(lib_handle);
   }
+  if (unoptimizedHandle) {
+    dlclose(unoptimizedHandle);
+    unoptimizedHandle = nullptr;
+  }
   lib_handle = dlopen(fullpath.data(), RTLD_NOW | RTLD_LOCAL);
   taco_uassert(lib_handle) << "Failed to load generated code, error is: " << dlerror();
+}
 
-  return fullpath;
+void Module::optimize(string prefix) {
+  string fullpath = getLibraryPath(prefix, true);
+  string cmd = getCompileCommand(prefix, true);
+
+  // A failed optimization is not an error, since the unoptimized library
+  // remains usable
+  if (system(cmd.data()) != 0) {
+    return;
+  }
+  void* handle = dlopen(fullpath.data(), RTLD_NOW | RTLD_LOCAL);
+  if (!handle) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(libHandleMutex);
+    // Callers may still hold function pointers into the unoptimized library,
+    // so it stays loaded until the module is recompiled
+    unoptimizedHandle = lib_handle;
+    lib_handle = handle;
+  }
+  storeInCache(fullpath);
+}
+
+void Module::waitForOptimization() {
+  if (optimization.valid()) {
+    optimization.get();
+  }
+}
+
+void Module::setCacheKey(string key) {
+  cacheKey = key;
+}
+
+string Module::getCachePrefix() const {
+  string cachedir = util::getFromEnv("TACO_KERNEL_CACHE_DIR", "");
+  if (cacheKey.empty() || cachedir.empty() || moduleFromUserSource) {
+    return "";
+  }
+  if (cachedir.back() != '/') {
+    cachedir += '/';
+  }
+  if (mkdir(cachedir.c_str(), 0755) != 0 && errno != EEXIST) {
+    return "";
+  }
+
+  // The library is content-addressed by everything that determines its
+  // contents: the statement it was generated from and the compiler invocation.
+  // The placeholder prefix keeps the per-process temporary paths out of the
+  // hashed command.
+  return cachedir + util::fnv1aHex(cacheKey + "\n" + getCompileCommand(""));
+}
+
+bool Module::loadFromCache() {
+  string cachePrefix = getCachePrefix();
+  if (cachePrefix.empty() || access((cachePrefix + ".so").c_str(), R_OK) != 0) {
+    return false;
+  }
+
+  void* handle = dlopen((cachePrefix + ".so").c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (!handle) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(libHandleMutex);
+    if (lib_handle) {
+      dlclose(lib_handle);
+    }
+    lib_handle = handle;
+  }
+
+  ifstream source_file(cachePrefix + ".c");
+  if (source_file.is_open()) {
+    source.str("");
+    source.clear();
+    source << source_file.rdbuf();
+  }
+  return true;
+}
+
+namespace {
+
+/// Write `contents` to the file `to` such that concurrent readers of `to` see
+/// either no file or the complete file: the contents are first written to a
+/// file private to this process, which is then renamed into place.
+void publishFile(const string& contents, string to, string uniqueSuffix) {
+  string tmp = to + ".tmp." + util::toString(getpid()) + "." + uniqueSuffix;
+  {
+    ofstream out(tmp, ios::binary);
+    if (!out.is_open()) {
+      return;
+    }
+    out << contents;
+    if (!out) {
+      out.close();
+      remove(tmp.c_str());
+      return;
+    }
+  }
+  if (rename(tmp.c_str(), to.c_str()) != 0) {
+    remove(tmp.c_str());
+  }
+}
+
+} // anonymous namespace
+
+void Module::storeInCache(string fullpath) {
+  string cachePrefix = getCachePrefix();
+  if (cachePrefix.empty()) {
+    return;
+  }
+
+  ifstream library(fullpath, ios::binary);
+  if (!library.is_open()) {
+    return;
+  }
+  stringstream contents;
+  contents << library.rdbuf();
+
+  // Publish the source before the library, since the presence of the library
+  // is what marks a cache entry as complete.
+  publishFile(source.str(), cachePrefix + ".c", libname);
+  publishFile(contents.str(), cachePrefix + ".so", libname);
 }
 
 void Module::setSource(string source) {
@@ -261,6 +437,7 @@ string Module::getSource() {
 }
 
 void* Module::getFuncPtr(std::string name) {
+  std::lock_guard<std::mutex> lock(libHandleMutex);
   return dlsym(lib_handle, name.data());
 }
 
@@ -9,6 +9,9 @@
 #include "taco/lower/mode_format_dense.h"
 #include "taco/lower/mode_format_compressed.h"
 #include "taco/lower/mode_format_singleton.h"
+#include "taco/lower/mode_format_block.h"
+#include "taco/lower/mode_format_hashed.h"
+#include "taco/lower/mode_format_bitmap.h"
 
 #include "taco/error.h"
 #include "taco/util/strings.h"
@@ -80,14 +83,14 @@ const std::vector<std::vector<Datatype>>& Format::getLevelArrayTypes() const {
 
 Datatype Format::getCoordinateTypePos(size_t level) const {
   if (level >= levelArrayTypes.size()) {
-    return Int32;
+    return indexType;
   }
   return levelArrayTypes[level][0];
 }
 
 Datatype Format::getCoordinateTypeIdx(size_t level) const {
   if (level >= levelArrayTypes.size()) {
-    return Int32;
+    return indexType;
   }
   if (getModeFormats()[level].getName() == Dense.getName()) {
     return levelArrayTypes[level][0];
@@ -99,6 +102,21 @@ void Format::setLevelArrayTypes(std::vector<std::vector<Datatype>> levelArrayTyp
   this->levelArrayTypes = levelArrayTypes;
 }
 
+Datatype Format::getIndexType() const {
+  return indexType;
+}
+
+void Format::setIndexType(Datatype indexType) {
+  taco_uassert(indexType == Int32 || indexType == Int64)
+      << "Index type must be Int32 or Int64, not " << indexType;
+  this->indexType = indexType;
+  for (auto& arrayTypes : levelArrayTypes) {
+    for (auto& arrayType : arrayTypes) {
+      arrayType = indexType;
+    }
+  }
+}
+
 
 bool operator==(const Format& a, const Format& b){
   const auto aModeTypePacks = a.getModeFormatPacks();
@@ -107,7 +125,8 @@ bool operator==(const Format& a, const Format& b){
   const auto bModeOrdering = b.getModeOrdering();
   
   if (aModeTypePacks.size() != bModeTypePacks.size() || 
-      aModeOrdering.size() != bModeOrdering.size()) {
+      aModeOrdering.size() != bModeOrdering.size() ||
+      a.getIndexType() != b.getIndexType()) {
     return false;
   }
   for (size_t i = 0; i < aModeOrdering.size(); ++i) {
@@ -128,8 +147,12 @@ bool operator!=(const Format& a, const Format& b) {
 }
 
 std::ostream &operator<<(std::ostream& os, const Format& format) {
-  return os << "(" << util::join(format.getModeFormatPacks(), ",") << "; "
-            << util::join(format.getModeOrdering(), ",") << ")";
+  os << "(" << util::join(format.getModeFormatPacks(), ",") << "; "
+     << util::join(format.getModeOrdering(), ",");
+  if (format.getIndexType() != Int32) {
+    os << "; " << format.getIndexType();
+  }
+  return os << ")";
 }
 
 
@@ -314,6 +337,16 @@ std::vector<AttrQuery> ModeFormat::getAttrQueries(
   return impl->attrQueries(parentCoords, childCoords);
 }
 
+int ModeFormat::getFixedSize() const {
+  taco_iassert(defined());
+  return impl->getFixedSize();
+}
+
+int ModeFormat::getTableSize(int dimension) const {
+  taco_iassert(defined());
+  return impl->getTableSize(dimension);
+}
+
 bool ModeFormat::defined() const {
   return impl != nullptr;
 }
@@ -405,6 +438,33 @@ const Format CSC({Dense, Sparse}, {1,0});
 const Format DCSR({Sparse, Sparse}, {0,1});
 const Format DCSC({Sparse, Sparse}, {1,0});
 
+ModeFormat DenseBlock(int blockSize) {
+  return ModeFormat(std::make_shared<BlockModeFormat>(blockSize));
+}
+
+ModeFormat Hashed(int tableSize) {
+  return ModeFormat(std::make_shared<HashedModeFormat>(tableSize));
+}
+
+const ModeFormat Bitmap(std::make_shared<BitmapModeFormat>());
+
+const Format BCSR(int blockRows, int blockCols) {
+  return Format({Dense, Sparse, DenseBlock(blockRows), DenseBlock(blockCols)});
+}
+
+const Format BCSF(const std::vector<int>& blockSizes) {
+  taco_uassert(!blockSizes.empty());
+  std::vector<ModeFormatPack> modeTypes(blockSizes.size(), Sparse);
+  for (int blockSize : blockSizes) {
+    modeTypes.push_back(DenseBlock(blockSize));
+  }
+  return Format(modeTypes);
+}
+
+const Format SELL(int sliceSize) {
+  return Format({Dense, Compressed, DenseBlock(sliceSize), Singleton});
+}
+
 const Format COO(int order, bool isUnique, bool isOrdered, bool isAoS, 
                  const std::vector<int>& modeOrdering) {
   taco_uassert(order > 0);
@@ -1,8 +1,10 @@
 #include "taco/index_notation/index_notation.h"
 
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <utility>
 #include <set>
@@ -25,6 +27,7 @@
 #include "taco/index_notation/index_notation_rewriter.h"
 #include "taco/index_notation/index_notation_printer.h"
 #include "taco/accelerator_notation/accelerate_search.h"
+#include "taco/accelerator_notation/cost_model.h"
 #include "taco/accelerator_notation/accelerator_notation_nodes.h"
 #include "taco/accelerator_notation/code_gen_dynamic_order.h"
 #include "taco/ir/ir.h"
@@ -38,6 +41,7 @@
 #include "taco/util/collections.h"
 #include "taco/util/functions.h"
 #include "taco/util/env.h"
+#include "taco/util/parallel.h"
 
 
 
@@ -778,6 +782,75 @@ bool isomorphic(IndexStmt a, IndexStmt b) {
   return Isomorphic().check(a,b);
 }
 
+std::string toCanonicalString(IndexStmt stmt) {
+  if (!stmt.defined()) {
+    return "";
+  }
+
+  map<string,TensorVar> tensorVars;
+  set<string> indexVars;
+  auto addAccess = [&](const Access& access) {
+    tensorVars.insert({access.getTensorVar().getName(), access.getTensorVar()});
+    for (auto& var : access.getIndexVars()) {
+      indexVars.insert(var.getName());
+    }
+  };
+  match(stmt,
+    function<void(const AssignmentNode*,Matcher*)>([&](const AssignmentNode* op,
+                                                       Matcher* ctx) {
+      addAccess(op->lhs);
+      ctx->match(op->rhs);
+    }),
+    function<void(const AccessNode*)>([&](const AccessNode* op) {
+      addAccess(Access(op));
+    }),
+    function<void(const ForallNode*,Matcher*)>([&](const ForallNode* op,
+                                                   Matcher* ctx) {
+      indexVars.insert(op->indexVar.getName());
+      ctx->match(op->stmt);
+    })
+  );
+
+  // Rename every identifier that names a tensor or an index variable. The
+  // replacement names contain a character that cannot appear in identifiers,
+  // so they never clash with the remaining (keyword) identifiers.
+  const string printed = util::toString(stmt);
+  map<string,string> renamed;
+  vector<TensorVar> tensorOrder;
+  stringstream canonical;
+  for (size_t i = 0; i < printed.size();) {
+    const char c = printed[i];
+    if (isalpha(c) || c == '_' || isdigit(c)) {
+      size_t j = i + 1;
+      while (j < printed.size() && (isalnum(printed[j]) || printed[j] == '_' ||
+             (isdigit(c) && printed[j] == '.'))) {
+        j++;
+      }
+      const string token = printed.substr(i, j - i);
+      if (!isdigit(c) && !util::contains(renamed, token)) {
+        if (util::contains(tensorVars, token)) {
+          renamed.insert({token, "$T" + util::toString(tensorOrder.size())});
+          tensorOrder.push_back(tensorVars.at(token));
+        } else if (util::contains(indexVars, token)) {
+          renamed.insert({token, "$i" + util::toString(renamed.size() -
+                                                       tensorOrder.size())});
+        }
+      }
+      canonical << (util::contains(renamed, token) ? renamed.at(token) : token);
+      i = j;
+    } else {
+      canonical << c;
+      i++;
+    }
+  }
+
+  for (size_t i = 0; i < tensorOrder.size(); i++) {
+    canonical << "; $T" << i << " : " << tensorOrder[i].getType()
+              << " " << tensorOrder[i].getFormat();
+  }
+  return canonical.str();
+}
+
 static void addCommutativityRewrite(IndexStmt stmt, std::map<IndexExpr, std::vector<IndexExpr>> &exprToreplace){
   
   
@@ -2820,8 +2893,9 @@ template <> Accelerate to<Accelerate>(IndexStmt s) {
 DimReduction::DimReduction(const DimReductionNode* n) : IndexStmt(n){
 }
 
-DimReduction::DimReduction(IndexStmt consumer, IndexStmt producer, std::vector<TensorVar> temps)
-    : DimReduction(new DimReductionNode(consumer, producer, temps)){
+DimReduction::DimReduction(IndexStmt consumer, IndexStmt producer, std::vector<TensorVar> temps,
+                           std::map<TensorVar, Access> aliases)
+    : DimReduction(new DimReductionNode(consumer, producer, temps, aliases)){
 }
 
 IndexStmt DimReduction::getConsumer(){
@@ -2836,6 +2910,10 @@ std::vector<TensorVar> DimReduction::getTemporaries(){
   return getNode(*this)->temps;
 }
 
+std::map<TensorVar, Access> DimReduction::getAliases(){
+  return getNode(*this)->aliases;
+}
+
 template <> bool isa<DimReduction>(IndexStmt s) {
   return isa<DimReductionNode>(s.ptr);
 }
@@ -2849,8 +2927,9 @@ template <> DimReduction to<DimReduction>(IndexStmt s) {
 InterfaceCall::InterfaceCall(const InterfaceCallNode* n) : IndexStmt(n) {
 }
 
-InterfaceCall::InterfaceCall(Assignment producer, ConcreteAccelerateCodeGenerator accelGen, TensorVar temp)
-  : InterfaceCall(new InterfaceCallNode(producer, accelGen, temp)){
+InterfaceCall::InterfaceCall(Assignment producer, ConcreteAccelerateCodeGenerator accelGen, TensorVar temp,
+                             IndexStmt remainder)
+  : InterfaceCall(new InterfaceCallNode(producer, accelGen, temp, remainder)){
 }
 
 Assignment InterfaceCall::getProducer(){
@@ -2865,6 +2944,10 @@ TensorVar InterfaceCall::getTemporary(){
   return getNode(*this)->temp;
 }
 
+IndexStmt InterfaceCall::getRemainder(){
+  return getNode(*this)->remainder;
+}
+
 template <> bool isa<InterfaceCall>(IndexStmt s) {
   return isa<InterfaceCallNode>(s.ptr);
 }
@@ -4046,6 +4129,15 @@ static std::vector<Argument> getConcreteArgs(const std::vector<Argument>& abstra
     case DIM:
         newArgs.push_back(new DimArg(argumentMap.indexVars.at(arg.getNode<DimArg>()->indexVar)));
         break;
+    case DIM_PRODUCT:
+    {
+      std::vector<IndexVar> indexVars;
+      for (const auto& indexVar : arg.getNode<DimProduct>()->indexVars){
+        indexVars.push_back(argumentMap.indexVars.at(indexVar));
+      }
+      newArgs.push_back(new DimProduct(indexVars));
+      break;
+    }
     case TENSOR:
       taco_uerror << "Arguments can only use TensorObjects, tried using a TensorVar." << endl;
       break; 
@@ -4148,7 +4240,7 @@ static ConcreteAccelerateCodeGenerator getConcreteCodeGenerator(IndexExpr expr,
     e = workspace;
   }
 
-  ConcreteAccelerateCodeGenerator concreteCodeGen = ConcreteAccelerateCodeGenerator(functionInterface.getNode()->getFunctionName(), functionInterface.getNode()->getReturnType(), e, expr, newArgs, callBefore, callAfter);
+  ConcreteAccelerateCodeGenerator concreteCodeGen = ConcreteAccelerateCodeGenerator(functionInterface.getNode()->getFunctionName(), functionInterface.getNode()->getReturnType(), e, expr, newArgs, callBefore, callAfter, functionInterface.getNode()->isThreadSafe());
 
   return concreteCodeGen;
 }
@@ -4176,6 +4268,42 @@ static std::map<IndexExpr, IndexExpr> toMatchVars(IndexExpr exprToAccelerate, st
 
 }
 
+/// Returns true if the slice an access reads once the index variables held
+/// constant are fixed is stored contiguously, in the dense row-major layout of
+/// the temporary it would otherwise be gathered into.  This holds when the
+/// operand is dense, the held variables index its outermost stored modes, and
+/// the remaining modes are stored in the order they are accessed, which covers
+/// row slices of row-major and column slices of column-major operands.
+static bool isContiguousSlice(Access access, std::vector<IndexVar> indexVarsToHoldConstant){
+  TensorVar tensor = access.getTensorVar();
+  if (tensor.getOrder() == 0 || !isDense(tensor.getFormat()) ||
+      access.hasWindowedModes() || access.hasIndexSetModes()) {
+    return false;
+  }
+
+  const std::vector<IndexVar>& indexVars = access.getIndexVars();
+  if (std::set<IndexVar>(indexVars.begin(), indexVars.end()).size() != indexVars.size()) {
+    return false;
+  }
+
+  bool inSlice = false;
+  int lastMode = -1;
+  for (int mode : tensor.getFormat().getModeOrdering()) {
+    if (util::contains(indexVarsToHoldConstant, indexVars[mode])) {
+      if (inSlice) {
+        return false;
+      }
+    } else {
+      if (mode < lastMode) {
+        return false;
+      }
+      inSlice = true;
+      lastMode = mode;
+    }
+  }
+  return true;
+}
+
 static IndexStmt constructInnerForalls(IndexExpr e, std::vector<IndexVar> indexVarsToHoldConstant, std::map<IndexExpr, IndexExpr> constructMap, IndexExpr toAccelerate){
 
   IndexStmt s; 
@@ -4220,6 +4348,10 @@ static IndexStmt constructInnerForalls(IndexExpr e, std::vector<IndexVar> indexV
       }
     }
   }
+
+  if (stmts.empty()){
+    return s;
+  }
  
   int i = 0;
   for (auto iVar: iVars){
@@ -4283,6 +4415,38 @@ static IndexStmt constructProducer(Access workspace, Access result, std::vector<
 
 }
 
+/// Returns true if the expression, with the index variables in
+/// indexVarsToHoldConstant held constant, matches the statement of a batched
+/// interface whose batch is indexed by batchVar.  The match requires every
+/// operand to have the format of the corresponding tensor object, so the
+/// problems of the batch are laid out at a constant stride.
+static bool isBatchedMatch(FunctionInterface batchedInterface, IndexExpr exprToAccelerate,
+                           std::vector<IndexVar> indexVarsToHoldConstant, IndexVar batchVar){
+  AcceleratorStmt referenceStmt = batchedInterface.getNode()->getStmt();
+  if (!isa<AcceleratorAssignment>(referenceStmt)){
+    return false;
+  }
+  AcceleratorAssignment assign = to<AcceleratorAssignment>(referenceStmt);
+  std::vector<IndexVar> resultVars = assign.getLhs().getIndexVars();
+  if (resultVars.empty()){
+    return false;
+  }
+
+  ArgumentMap argumentMap;
+  if (indexVarsToHoldConstant.empty()){
+    argumentMap = hasPreciseMatch(exprToAccelerate, makeReductionNotation(assign).getRhs());
+    if (!argumentMap.possible){
+      argumentMap = hasPreciseMatch(exprToAccelerate, assign.getRhs());
+    }
+  } else {
+    IndexExpr e = replace(exprToAccelerate, toMatchVars(exprToAccelerate, indexVarsToHoldConstant));
+    argumentMap = hasPreciseMatch(e, assign.getRhs());
+  }
+
+  return argumentMap.possible && util::contains(argumentMap.indexVars, resultVars[0]) &&
+         argumentMap.indexVars.at(resultVars[0]) == batchVar;
+}
+
 static std::map<IndexExpr, IndexExpr> constructTiledVars(IndexExpr exprToAccelerate, std::map<IndexVar, int> varTilings, std::map<IndexVar, IndexVar> innerVarMapping){
 
   std::map<IndexExpr, IndexExpr> tensorVarToIndexVar;
@@ -4448,7 +4612,21 @@ IndexStmt IndexStmt::tile(FunctionInterface functionInterface, IndexExpr exprToA
   temps.push_back(interfaceResult.getTensorVar());
   Assignment replacedWithTiled =  to<Assignment>(replace(Assignment(interfaceResult, replace(exprToAccelerate, tensorAssigns)), innerVarMapping));  
   IndexExpr resExpr = replacedWithTiled.getLhs();
-  InterfaceCall call(replacedWithTiled, getConcreteCodeGenerator(replacedWithTiled.getRhs(), resExpr, hasPreciseMatch(replacedWithTiled.getRhs(), assign.getRhs()), functionInterface), interfaceResult.getTensorVar());
+
+  // Tiles that overhang the end of an index variable that does not divide
+  // evenly into tiles are computed with generated code instead of the call,
+  // since the unused part of the gathered tiles still holds the values of the
+  // previous tile.  The generated loops only visit the valid part of a tile.
+  IndexStmt remainder = makeConcreteNotation(makeReductionNotation(replacedWithTiled));
+  if (!getReductionVars(remainder).empty()){
+    IndexStmt zero = Assignment(to<Access>(resExpr), Literal::zero(resExpr.getDataType()));
+    for (auto var: resExpr.getIndexVars()){
+      zero = Forall(var, zero);
+    }
+    remainder = ForallMany({zero, remainder});
+  }
+
+  InterfaceCall call(replacedWithTiled, getConcreteCodeGenerator(replacedWithTiled.getRhs(), resExpr, hasPreciseMatch(replacedWithTiled.getRhs(), assign.getRhs()), functionInterface), interfaceResult.getTensorVar(), remainder);
 
   IndexStmt setWorkspace = Assignment(result, resExpr, Add());
 
@@ -4492,6 +4670,26 @@ IndexStmt IndexStmt::holdConstant(FunctionInterface functionInterface, IndexExpr
   if (indexVarsToHoldConstant.size() == 0){
     taco_uerror << "Please use the accelerate command!";
   }
+
+  // Coalesce the calls made for every value of a held index variable into a
+  // single call of the batched variant of the function, if it has one and the
+  // held variable indexes its batch.  Otherwise fall back to the loop.
+  FunctionInterface batchedInterface = functionInterface.getNode()->getBatchedInterface();
+  if (batchedInterface.defined()){
+    for (const auto &batchVar : indexVarsToHoldConstant){
+      std::vector<IndexVar> remainingVars;
+      for (const auto &var : indexVarsToHoldConstant){
+        if (var != batchVar){
+          remainingVars.push_back(var);
+        }
+      }
+      if (isBatchedMatch(batchedInterface, exprToAccelerate, remainingVars, batchVar)){
+        return remainingVars.empty()
+               ? accelerate(batchedInterface, exprToAccelerate)
+               : holdConstant(batchedInterface, exprToAccelerate, remainingVars, workspace);
+      }
+    }
+  }
   
   AcceleratorStmt referenceStmt = functionInterface.getNode()->getStmt();
   if (!isa<AcceleratorAssignment>(referenceStmt)){
@@ -4511,7 +4709,19 @@ IndexStmt IndexStmt::holdConstant(FunctionInterface functionInterface, IndexExpr
 
   Access result = constructResultAccess(argumentMap, e, functionInterface);
 
-  IndexStmt s = constructInnerForalls(e, indexVarsToHoldConstant, tensorVarToIndexVar, exprToAccelerate);
+  // Operand slices that are already laid out like their temporaries are
+  // passed to the interface in place; only the others are gathered.
+  std::map<TensorVar, Access> aliases;
+  std::map<IndexExpr, IndexExpr> toGather;
+  for (auto &entry: tensorVarToIndexVar){
+    if (isContiguousSlice(to<Access>(entry.first), indexVarsToHoldConstant)){
+      aliases.insert({to<Access>(entry.second).getTensorVar(), to<Access>(entry.first)});
+    } else {
+      toGather.insert(entry);
+    }
+  }
+
+  IndexStmt s = constructInnerForalls(e, indexVarsToHoldConstant, toGather, exprToAccelerate);
   IndexStmt producer = constructProducer(workspace, result, indexVarsToHoldConstant);
 
   InterfaceCall call(Assignment(result, e), getConcreteCodeGenerator(e, result, argumentMap, functionInterface), result.getTensorVar());
@@ -4524,14 +4734,17 @@ IndexStmt IndexStmt::holdConstant(FunctionInterface functionInterface, IndexExpr
   }
 
 
+  std::vector<IndexStmt> body;
+  for (const auto &stmt : {s, copyTemp, static_cast<IndexStmt>(call), producer}){
+    if (stmt.defined()){
+      body.push_back(stmt);
+    }
+  }
+
   int i = 0;
   for (const auto &constantVar : indexVarsToHoldConstant){
     if (i == 0){
-      if (copyTemp.defined()){
-        reducedCode = forall(constantVar, ForallMany(constantVar, {s, copyTemp, call, producer}));
-      }else{
-        reducedCode = forall(constantVar, ForallMany(constantVar, {s, call, producer}));
-      } 
+      reducedCode = forall(constantVar, ForallMany(constantVar, body));
     }else{
       reducedCode = forall(constantVar, reducedCode);
     }
@@ -4559,7 +4772,7 @@ IndexStmt IndexStmt::holdConstant(FunctionInterface functionInterface, IndexExpr
   }
   // return DimReduction(rewritten, reducedCode, temps);
 
-  return DimReduction(rewritten, reducedCode, temps);
+  return DimReduction(rewritten, reducedCode, temps, aliases);
 }
 
 
@@ -4798,154 +5011,234 @@ static vector<vector<int> > makeCombi(int n, int k)
     return ans;
 }
 
-IndexStmt IndexStmt::helperCheckForMatches(IndexStmt stmt, std::vector<FunctionInterface> functionInterfaces, std::set<std::pair<std::string, std::string>>& expressions) const{
+namespace {
 
-  std::stack<std::tuple<Access, ConcreteAccelerateCodeGenerator, FunctionInterface, ArgumentMap>> varCodeGen;
-  // std::map<ConcreteAccelerateCodeGenerator, FunctionInterface> abstractInterface;
+/// The outcome of matching an expression against a function interface.
+struct InterfaceMatch {
+  /// Whether the expression matches the interface, either precisely or with
+  /// some of its index variables held constant.
+  bool matched = false;
 
-  if (!isa<Assignment>(stmt)) {
-    cout << "Cannot autoschedule this expression since it is not an assignment" << endl;
-    return stmt;
+  /// Whether the expression can be replaced by a call to the interface: it
+  /// matches precisely and the interface's constraints can be satisfied.
+  bool replace = false;
+  ArgumentMap argumentMap;
+};
+
+/// The function interfaces that autoAccelerate maps to, together with state
+/// shared by the matching of every rewrite.  Matches are memoized by the
+/// printed expression and the function name, since the rewrites of a
+/// statement share most of their subexpressions.
+struct InterfaceMatcher {
+  InterfaceMatcher(const std::vector<FunctionInterface>& functionInterfaces)
+      : functionInterfaces(functionInterfaces) {
+    for (auto descripton : functionInterfaces) {
+      AcceleratorStmt referenceStmt = descripton.getNode()->getStmt();
+      if (!isa<AcceleratorAssignment>(referenceStmt)){
+        taco_uerror << "Reference statement in function interface must be an assignemnt" << endl;
+      }
+      AcceleratorAssignment assign = to<AcceleratorAssignment>(referenceStmt);
+      reduxRefStmts.push_back(makeReductionNotation(assign));
+    }
   }
 
-  IndexStmt stmtRewrite = stmt;
-  for (auto descripton: functionInterfaces){
-    AcceleratorStmt referenceStmt = descripton.getNode()->getStmt();
-    
-    if (!isa<AcceleratorAssignment>(referenceStmt)){
-      taco_uerror << "Reference statement in function interface must be an assignemnt" << endl;
+  std::vector<FunctionInterface> functionInterfaces;
+  std::vector<AcceleratorAssignment> reduxRefStmts;
+  OpPatternCache opPatterns;
+  std::mutex matchesMutex;
+  std::map<std::pair<std::string, std::string>, InterfaceMatch> matches;
+
+  /// Returns, for each function interface, the subexpressions of the
+  /// statement with the interface's op pattern.
+  std::vector<std::vector<IndexExpr>> getCandidates(IndexStmt stmt) {
+    std::vector<std::vector<IndexExpr>> candidates;
+    for (auto& reduxRefStmt : reduxRefStmts) {
+      candidates.push_back(allMatchedOpPatterns(to<Assignment>(stmt).getRhs(),
+                                                reduxRefStmt.getRhs(),
+                                                &opPatterns));
     }
+    return candidates;
+  }
 
-    AcceleratorAssignment assign = to<AcceleratorAssignment>(referenceStmt);
-    AcceleratorAssignment reduxRefStmt = makeReductionNotation(assign);
-    std::vector<IndexExpr> matchedExprs = allMatchedOpPatterns(to<Assignment>(stmt).getRhs(), reduxRefStmt.getRhs());
-    ArgumentMap argumentMap;
+  InterfaceMatch getMatch(IndexExpr expr, size_t interface) {
+    std::pair<std::string, std::string> key =
+        {util::toString(expr), functionInterfaces[interface].getNode()->getFunctionName()};
+    {
+      std::lock_guard<std::mutex> lock(matchesMutex);
+      if (matches.count(key)) {
+        return matches.at(key);
+      }
+    }
+    InterfaceMatch match = computeMatch(expr, interface);
+    std::lock_guard<std::mutex> lock(matchesMutex);
+    matches.insert({key, match});
+    return match;
+  }
 
-    for (auto expr: matchedExprs){
-      
-      stringstream ss; 
-      ss << expr; 
-
-      if (expressions.count({ss.str(), descripton.getNode()->getFunctionName()})) continue;
-      argumentMap = hasPreciseMatch(expr, reduxRefStmt.getRhs());
-      if (argumentMap.possible){
-        expressions.insert({ss.str(), descripton.getNode()->getFunctionName()});
-        // Generate STMT query if a constraint exists
-        // True indicates that we are interested in finding tilings.
-        if (descripton.getNode()->getConstraints().defined()){
-          std::map<IndexVar, int> currentDims;
-          for (auto entry : expr.getIndexVarDomains()){
-            currentDims[argumentMap.indexVars[entry.first]] = (int) entry.second.getSize();
-          }
-          // std::cout << "Check" << util::join(currentDims) << std::endl;
-          GenerateSMTCode condition(descripton.getNode()->getConstraints(), {}, currentDims, true);
+  InterfaceMatch computeMatch(IndexExpr expr, size_t interface) {
+    FunctionInterface descripton = functionInterfaces[interface];
+    AcceleratorAssignment reduxRefStmt = reduxRefStmts[interface];
 
-          // If we cannot satisfy query even with tilings, skip.
-          if (!condition.isSat()){
-            continue;
-          }
+    InterfaceMatch match;
+    ArgumentMap argumentMap = hasPreciseMatch(expr, reduxRefStmt.getRhs());
+    if (argumentMap.possible){
+      match.matched = true;
+      match.argumentMap = argumentMap;
+      match.replace = true;
+      // Generate STMT query if a constraint exists
+      // True indicates that we are interested in finding tilings.
+      if (descripton.getNode()->getConstraints().defined()){
+        std::map<IndexVar, int> currentDims;
+        for (auto entry : expr.getIndexVarDomains()){
+          currentDims[argumentMap.indexVars[entry.first]] = (int) entry.second.getSize();
         }
+        GenerateSMTCode condition(descripton.getNode()->getConstraints(), {}, currentDims, true);
+        // If we cannot satisfy query even with tilings, skip.
+        match.replace = condition.isSat();
+      }
+      return match;
+    }
 
-        // std::cout << descripton.getNode()->getFunctionName() << std::endl;
-        auto access = replaceTemporary(stmt, expr, reduxRefStmt, argumentMap);
-        std::map<IndexExpr,IndexExpr> subsitution = {{expr, access}};
-        stmtRewrite =  replace(stmtRewrite, subsitution);
-        auto codeGen = getConcreteCodeGenerator(expr, access, argumentMap, descripton);
-        // varCodeGen.push(std::make_tuple(access, codeGen, descripton, argumentMap));
-        // // break;
-        }else{
-          std::vector<IndexVar> allVars = taco::getIndexVars(expr);
-          // expressions.insert({ss.str(), descripton.getNode()->getFunctionName()});
-          bool found = false;
-
-          for (int i = 0; i < allVars.size(); i++){
-            // std::cout << "starting" << std::endl;
-            // We want to stop when we have found the minimum number of indices
-            // to hold constant.
-            auto samples = makeCombi(allVars.size(), i);
-            for (auto sample: samples){
-              std::vector<IndexVar> holdConstant;
-              for (auto s: sample){
-                holdConstant.push_back(allVars[s-1]);
-              }
-              // std::cout << util::join(holdConstant) << std::endl;
-              auto tensorVarsnew = toMatchVars(expr, holdConstant);
-              IndexExpr e = replace(expr, tensorVarsnew);
-
-              // std::cout << e << std::endl;
-              ArgumentMap argumentMapConst = hasPreciseMatch(e, reduxRefStmt.getRhs());
-              if (argumentMapConst.possible){
-                found = true;
-                expressions.insert({ss.str(), descripton.getNode()->getFunctionName()});
-
-                if (descripton.getNode()->getConstraints().defined()){
-                  std::map<IndexVar, int> currentDims;
-                  for (auto entry : e.getIndexVarDomains()){
-                    currentDims[argumentMap.indexVars[entry.first]] = (int) entry.second.getSize();
-                  }
-                  // std::cout << "Check" << util::join(currentDims) << std::endl;
-                  GenerateSMTCode condition(descripton.getNode()->getConstraints(), {}, currentDims, true);
+    // Otherwise look for the fewest index variables that, when held
+    // constant, make the expression a precise match.
+    std::vector<IndexVar> allVars = taco::getIndexVars(expr);
+    for (size_t i = 0; i < allVars.size(); i++){
+      for (auto sample: makeCombi(allVars.size(), i)){
+        std::vector<IndexVar> holdConstant;
+        for (auto s: sample){
+          holdConstant.push_back(allVars[s-1]);
+        }
+        auto tensorVarsnew = toMatchVars(expr, holdConstant);
+        IndexExpr e = replace(expr, tensorVarsnew);
+        if (hasPreciseMatch(e, reduxRefStmt.getRhs()).possible){
+          match.matched = true;
+          return match;
+        }
+      }
+    }
+    return match;
+  }
 
-                  // If we cannot satisfy query even with tilings, skip.
-                  if (!condition.isSat()){
-                    continue;
-                  }
-                }
-               }
-             }
-          if (found){
-            break;
+  /// Replaces the subexpressions of the statement that match an interface,
+  /// skipping (expression, function) pairs already in `expressions`.  The
+  /// replaced subexpressions are added to `mappings` if it is given.
+  IndexStmt rewrite(IndexStmt stmt,
+                    const std::vector<std::vector<IndexExpr>>& candidates,
+                    std::set<std::pair<std::string, std::string>>& expressions,
+                    std::vector<std::pair<IndexExpr, FunctionInterface>>* mappings=nullptr) {
+    IndexStmt stmtRewrite = stmt;
+    for (size_t interface = 0; interface < functionInterfaces.size(); interface++){
+      FunctionInterface descripton = functionInterfaces[interface];
+      for (auto expr : candidates[interface]){
+        std::pair<std::string, std::string> key =
+            {util::toString(expr), descripton.getNode()->getFunctionName()};
+        if (expressions.count(key)) continue;
+
+        InterfaceMatch match = getMatch(expr, interface);
+        if (match.matched){
+          expressions.insert(key);
+        }
+        if (match.replace){
+          auto access = replaceTemporary(stmt, expr, reduxRefStmts[interface], match.argumentMap);
+          std::map<IndexExpr,IndexExpr> subsitution = {{expr, access}};
+          stmtRewrite =  replace(stmtRewrite, subsitution);
+          auto codeGen = getConcreteCodeGenerator(expr, access, match.argumentMap, descripton);
+          if (mappings){
+            mappings->push_back({expr, descripton});
           }
-         }
         }
       }
+    }
+    return makeConcreteNotation(stmtRewrite);
   }
-  
-  stmtRewrite = makeConcreteNotation(stmtRewrite);
+};
+
+} // anonymous namespace
 
-  while (!varCodeGen.empty()){
-    auto tensorCodeGen = varCodeGen.top();
-    stmtRewrite = rewriteStmt(stmtRewrite, std::get<0>(tensorCodeGen), std::get<1>(tensorCodeGen), std::get<2>(tensorCodeGen), std::get<3>(tensorCodeGen));
-    varCodeGen.pop();
+IndexStmt IndexStmt::helperCheckForMatches(IndexStmt stmt, std::vector<FunctionInterface> functionInterfaces, std::set<std::pair<std::string, std::string>>& expressions) const{
+  if (!isa<Assignment>(stmt)) {
+    cout << "Cannot autoschedule this expression since it is not an assignment" << endl;
+    return stmt;
   }
+  InterfaceMatcher matcher(functionInterfaces);
+  return matcher.rewrite(stmt, matcher.getCandidates(stmt), expressions);
+}
 
-  return stmtRewrite;
+std::vector<IndexStmt> IndexStmt::autoAccelerate(IndexStmt stmt, std::vector<FunctionInterface> functionInterfaces,
+                                                 AutoAccelerateStats* stats) const{
+  std::vector<IndexStmt> possibleStmts;
+  for (auto& candidate : autoAccelerateCandidates(stmt, functionInterfaces, stats)){
+    possibleStmts.push_back(candidate.stmt);
+  }
+  return possibleStmts;
 }
 
-std::vector<IndexStmt> IndexStmt::autoAccelerate(IndexStmt stmt, std::vector<FunctionInterface> functionInterfaces) const{
+std::vector<AcceleratedCandidate> IndexStmt::autoAccelerateCandidates(IndexStmt stmt, std::vector<FunctionInterface> functionInterfaces,
+                                                                      AutoAccelerateStats* stats) const{
 
   auto start1 = std::chrono::high_resolution_clock::now();
 
   std::vector<IndexStmt> possibleRewrites = generateEquivalentStmts(stmt, 3);
-  std::vector<IndexStmt> possibleStmts;
-  possibleStmts.push_back(makeConcreteNotation(stmt));
+  std::vector<AcceleratedCandidate> possibleStmts;
+  possibleStmts.push_back({makeConcreteNotation(stmt), {}, stmt});
+
+  // Rewrites that are identical up to renaming match the same interfaces.
+  // The first rewrite is the statement itself.
+  std::vector<IndexStmt> uniqueRewrites;
+  std::set<std::string> canonicalRewrites;
+  for (auto& rewrite : possibleRewrites){
+    if (canonicalRewrites.insert(toCanonicalString(rewrite)).second){
+      uniqueRewrites.push_back(rewrite);
+    }
+  }
 
   std::set<std::pair<std::string, std::string>> expressions;
   // Account for the case where there are no mappings.
   expressions.insert({"", ""});
-  helperCheckForMatches(stmt, functionInterfaces, expressions);
 
-  for (int i = 0; i < possibleRewrites.size(); i++){
-      possibleStmts.push_back(helperCheckForMatches(possibleRewrites[i], functionInterfaces, expressions));
-  }
+  if (isa<Assignment>(stmt)){
+    InterfaceMatcher matcher(functionInterfaces);
+
+    // Matching is independent for each rewrite and interface, so it is done
+    // in parallel up front.  Rewriting the statements depends on which
+    // matches earlier rewrites made, so it happens in order afterwards.
+    std::vector<std::vector<std::vector<IndexExpr>>> candidates(uniqueRewrites.size());
+    util::parallelFor(uniqueRewrites.size(), [&](size_t i) {
+      candidates[i] = matcher.getCandidates(uniqueRewrites[i]);
+      for (size_t interface = 0; interface < candidates[i].size(); interface++){
+        for (auto& expr : candidates[i][interface]){
+          matcher.getMatch(expr, interface);
+        }
+      }
+    });
 
+    // The first rewrite is the statement itself, so its candidate holds the
+    // mappings of the statement and the others those found through rewrites.
+    for (size_t i = 0; i < uniqueRewrites.size(); i++){
+      AcceleratedCandidate candidate;
+      candidate.stmt = matcher.rewrite(uniqueRewrites[i], candidates[i], expressions,
+                                       &candidate.mappings);
+      candidate.rewrite = uniqueRewrites[i];
+      possibleStmts.push_back(candidate);
+    }
+  }
+  else {
+    cout << "Cannot autoschedule this expression since it is not an assignment" << endl;
+    for (auto& rewrite : uniqueRewrites){
+      possibleStmts.push_back({rewrite, {}, rewrite});
+    }
+  }
 
-  // std::cout << " check ";
   auto end1 = std::chrono::high_resolution_clock::now();
-
-  auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end1 - start1);
-
-  std::cout << "Time taken to Run Completely: "
-        << float(duration.count())/float(1000000) << "s" << std::endl;
-
-  std::cout << "Total Number: "
-        << expressions.size() << std::endl;
-  for (auto mappings: expressions){
-    std::cout << mappings.first << " " << mappings.second << std::endl;
+  if (stats){
+    stats->rewrites = possibleRewrites.size();
+    stats->uniqueRewrites = uniqueRewrites.size();
+    stats->candidates = possibleStmts.size();
+    stats->mappings = expressions;
+    stats->mappings.erase({"", ""});
+    stats->seconds = std::chrono::duration<double>(end1 - start1).count();
   }
 
-
-
   return possibleStmts;
 }
 
@@ -5592,6 +5885,7 @@ std::vector<IndexVar> getReductionVars(IndexStmt stmt) {
 
   std::vector<IndexVar> reductionVars, scopedVars, producerScopedVars, 
                         consumerScopedVars;
+  std::set<TensorVar> dimReductionTemps;
   match(stmt,
     function<void(const ForallNode*,Matcher*)>([&](const ForallNode* op, 
                                                    Matcher* ctx) {
@@ -5616,7 +5910,19 @@ std::vector<IndexVar> getReductionVars(IndexStmt stmt) {
       ctx->match(op->consumer);
       consumerScopedVars = oldConsumerScopedVars;
     }),
+    function<void(const DimReductionNode*,Matcher*)>([&](const DimReductionNode* op,
+                                                         Matcher* ctx) {
+      dimReductionTemps.insert(op->temps.begin(), op->temps.end());
+      ctx->match(op->consumer);
+      ctx->match(op->producer);
+    }),
     function<void(const AssignmentNode*)>([&](const AssignmentNode* op) {
+      // Operands gathered into the temporaries of a dimension reduction are
+      // overwritten in every iteration of the enclosing loops, not reduced
+      if (!op->op.defined() &&
+          util::contains(dimReductionTemps, op->lhs.getTensorVar())) {
+        return;
+      }
       auto freeVars = op->lhs.getIndexVars();
       util::append(freeVars, producerScopedVars);
 
@@ -6014,7 +6320,7 @@ private:
       stmt = op;
     }
     else {
-      stmt = new DimReductionNode(consumer, producer, op->temps);
+      stmt = new DimReductionNode(consumer, producer, op->temps, op->aliases);
     }
   }
 
@@ -6045,7 +6351,7 @@ private:
       stmt = op;
     }
     else {
-      stmt = new InterfaceCallNode(op->producer, op->codeGen, op->temp);
+      stmt = new InterfaceCallNode(op->producer, op->codeGen, op->temp, op->remainder);
     }
   }
 
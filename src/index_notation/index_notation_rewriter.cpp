@@ -225,7 +225,7 @@ void IndexNotationRewriter::visit(const DimReductionNode* op) {
     stmt = op;
   }
   else {
-    stmt = new DimReductionNode(consumer, producer, op->temps);
+    stmt = new DimReductionNode(consumer, producer, op->temps, op->aliases);
   }
 }
 
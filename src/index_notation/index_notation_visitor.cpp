@@ -150,6 +150,11 @@ void IndexNotationVisitor::visit(const SuchThatNode* op) {
 }
 
 void IndexNotationVisitor::visit(const DimReductionNode* op){
+  // Operands aliased by temporaries are read in place, without a gather
+  // statement that accesses them
+  for (const auto& alias : op->aliases) {
+    alias.second.accept(this);
+  }
   op->producer.accept(this);
   op->consumer.accept(this);
 }
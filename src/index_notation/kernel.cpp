@@ -19,6 +19,7 @@ namespace taco {
 
 struct Kernel::Content {
   shared_ptr<ir::Module> module;
+  string prefix;
 };
 
 Kernel::Kernel() : content(nullptr) {
@@ -29,8 +30,10 @@ Kernel::Kernel() : content(nullptr) {
 }
 
 Kernel::Kernel(IndexStmt stmt, shared_ptr<ir::Module> module, void* evaluate,
-               void* assemble, void* compute) : content(new Content) {
+               void* assemble, void* compute, string prefix)
+    : content(new Content) {
   content->module = module;
+  content->prefix = prefix;
   this->numResults = getResults(stmt).size();
   this->evaluateFunction = evaluate;
   this->assembleFunction = assemble;
@@ -71,6 +74,22 @@ void unpackResults(size_t numResults, const vector<void*> arguments,
                           size, Array::UserOwns);
         modeIndices.push_back(ModeIndex({pos, idx}));
         num = size;
+      } else if (modeType.getName() == Hashed().getName()) {
+        const int mode = format.getModeOrdering()[i];
+        num *= modeType.getTableSize(tensorData->dimensions[mode]);
+        Array idx = Array(type<int>(), tensorData->indices[i][1],
+                          num, Array::UserOwns);
+        modeIndices.push_back(ModeIndex({makeArray(type<int>(), 0), idx}));
+      } else if (modeType.getName() == Bitmap.getName()) {
+        const int mode = format.getModeOrdering()[i];
+        const size_t numWords = num * ((tensorData->dimensions[mode] + 63) / 64);
+        auto size = ((int*)tensorData->indices[i][0])[numWords];
+        Array pos = Array(type<int>(), tensorData->indices[i][0],
+                          numWords+1, Array::UserOwns);
+        Array bits = Array(UInt64, tensorData->indices[i][1],
+                           numWords, Array::UserOwns);
+        modeIndices.push_back(ModeIndex({pos, bits}));
+        num = size;
       } else {
         taco_not_supported_yet;
       }
@@ -82,24 +101,39 @@ void unpackResults(size_t numResults, const vector<void*> arguments,
 
 bool Kernel::operator()(const vector<TensorStorage>& args) const {
   vector<void*> arguments = packArguments(args);
-  int result = content->module->callFuncPacked("evaluate", arguments.data());
+  int result = content->module->callFuncPacked(content->prefix + "evaluate",
+                                                   arguments.data());
   unpackResults(this->numResults, arguments, args);
   return (result == 0);
 }
 
 bool Kernel::assemble(const vector<TensorStorage>& args) const {
   vector<void*> arguments = packArguments(args);
-  int result = content->module->callFuncPacked("assemble", arguments.data());
+  int result = content->module->callFuncPacked(content->prefix + "assemble",
+                                                   arguments.data());
   unpackResults(this->numResults, arguments, args);
   return (result == 0);
 }
 
 bool Kernel::compute(const vector<TensorStorage>& args) const {
   vector<void*> arguments = packArguments(args);
-  int result = content->module->callFuncPacked("compute", arguments.data());
+  int result = content->module->callFuncPacked(content->prefix + "compute",
+                                                   arguments.data());
   return (result == 0);
 }
 
+void* Kernel::getEvaluateFunction() const {
+  return evaluateFunction;
+}
+
+void* Kernel::getAssembleFunction() const {
+  return assembleFunction;
+}
+
+void* Kernel::getComputeFunction() const {
+  return computeFunction;
+}
+
 bool Kernel::defined() {
   return content != nullptr;
 }
@@ -108,18 +142,23 @@ std::ostream& operator<<(std::ostream& os, const Kernel& kernel) {
   return os << kernel.content->module->getSource();
 }
 
-Kernel compile(IndexStmt stmt) {
+static void addKernelFunctions(shared_ptr<ir::Module> module, IndexStmt stmt,
+                               string prefix) {
   string reason;
   taco_uassert(isConcreteNotation(stmt, &reason))
       << "Statement not valid concrete index notation and cannot be compiled. "
       << reason << endl << stmt;
 
+  IndexStmt parallelStmt = parallelizeOuterLoop(stmt);
+  module->addFunction(lower(parallelStmt, prefix + "compute",  false, true));
+  module->addFunction(lower(stmt, prefix + "assemble", true, false));
+  module->addFunction(lower(stmt, prefix + "evaluate", true, true));
+}
+
+Kernel compile(IndexStmt stmt) {
   shared_ptr<ir::Module> module(new ir::Module);
   // module->setSource("~/temp");
-  IndexStmt parallelStmt = parallelizeOuterLoop(stmt);
-  module->addFunction(lower(parallelStmt, "compute",  false, true));
-  module->addFunction(lower(stmt, "assemble", true, false));
-  module->addFunction(lower(stmt, "evaluate", true, true));
+  addKernelFunctions(module, stmt, "");
   module->compile();
 
   void* evaluate = module->getFuncPtr("evaluate");
@@ -129,4 +168,29 @@ Kernel compile(IndexStmt stmt) {
   return Kernel(stmt, module, evaluate, assemble, compute);
 }
 
+vector<Kernel> compile(const vector<IndexStmt>& stmts) {
+  if (stmts.empty()) {
+    return {};
+  }
+
+  shared_ptr<ir::Module> module(new ir::Module);
+  vector<string> prefixes;
+  for (size_t i = 0; i < stmts.size(); i++) {
+    prefixes.push_back("k" + to_string(i) + "_");
+    addKernelFunctions(module, stmts[i], prefixes.back());
+  }
+  module->compile();
+
+  vector<Kernel> kernels;
+  for (size_t i = 0; i < stmts.size(); i++) {
+    const string& prefix = prefixes[i];
+    void* evaluate = module->getFuncPtr(prefix + "evaluate");
+    void* assemble = module->getFuncPtr(prefix + "assemble");
+    void* compute  = module->getFuncPtr(prefix + "compute");
+    kernels.push_back(Kernel(stmts[i], module, evaluate, assemble, compute,
+                             prefix));
+  }
+  return kernels;
+}
+
 }
@@ -203,14 +203,37 @@ IndexStmt SetMergeStrategy::apply(IndexStmt stmt, string* reason) const {
             return;
           }
         }
-        if (lattice.points().size() != 1) {
+        MergeStrategy strategy = transformation.getMergeStrategy();
+        if (lattice.points().size() != 1 && 
+            (strategy == MergeStrategy::Gallop ||
+             strategy == MergeStrategy::SIMDBlock)) {
           reason = "Precondition failed: The merge lattice of variable " 
                 + i.getName() +
                 " has more than 1 point and cannot be merged by galloping";
           return;
         }
 
-        MergeStrategy strategy = transformation.getMergeStrategy();
+        if (strategy == MergeStrategy::MergePath) {
+          // Partitions of the merge path run in parallel, so each must
+          // write to distinct components of the results
+          if (any(lattice.results(), [](Iterator it){return it.hasAppend();})) {
+            reason = "Precondition failed: Variable " + i.getName() +
+                     " appends to a result and cannot be merged by merge path";
+            return;
+          }
+          bool reduces = false;
+          match(foralli.getStmt(),
+            function<void(const AssignmentNode*)>([&](const AssignmentNode* op) {
+              reduces |= !util::contains(op->lhs.getIndexVars(), i);
+            })
+          );
+          if (reduces) {
+            reason = "Precondition failed: Variable " + i.getName() +
+                     " is reduced over and cannot be merged by merge path";
+            return;
+          }
+        }
+
         stmt = rewrite(foralli.getStmt());
         stmt = Forall(node->indexVar, stmt, strategy, node->parallel_unit, 
                       node->output_race_strategy, node->unrollFactor);
@@ -1162,6 +1185,22 @@ IndexStmt Parallelize::apply(IndexStmt stmt, std::string* reason) const {
                                                            iterators, provGraph, 
                                                            definedIndexVars);
 
+        // Precondition 4: Every external function called in the loop must be
+        //                 safe to call from several threads at once
+        bool callsThreadUnsafeFunction = false;
+        match(foralli.getStmt(),
+              function<void(const InterfaceCallNode*)>([&](const InterfaceCallNode* node) {
+                if (!node->codeGen.isThreadSafe()) {
+                  callsThreadUnsafeFunction = true;
+                }
+              })
+        );
+        if (callsThreadUnsafeFunction) {
+          reason = "Precondition failed: The loop calls a function that is "
+                   "not thread safe";
+          return;
+        }
+
         // Precondition 3: Every result iterator must have insert capability
         for (Iterator iterator : underivedLattice.results()) {
           if (util::contains(assembledByUngroupedInsert, iterator.getTensor())) {
@@ -854,7 +854,7 @@ Stmt Print::make(std::string fmt, std::vector<Expr> params) {
 }
   
 Expr GetProperty::make(Expr tensor, TensorProperty property, int mode,
-                       int index, std::string name) {
+                       int index, std::string name, Datatype type) {
   GetProperty* gp = new GetProperty;
   gp->tensor = tensor;
   gp->property = property;
@@ -866,7 +866,7 @@ Expr GetProperty::make(Expr tensor, TensorProperty property, int mode,
   if (property == TensorProperty::Values)
     gp->type = tensor.type();
   else
-    gp->type = Int();
+    gp->type = type;
   
   return gp;
 }
@@ -87,9 +87,14 @@ Iterator::Iterator(IndexVar indexVar, Expr tensor, Mode mode, Iterator parent,
   if (useNameForPos) {
     posNamePrefix = name;
   }
-  content->posVar   = Var::make(name,            indexVar.getDataType());
-  content->endVar   = Var::make("p" + modeName + "_end",   indexVar.getDataType());
-  content->beginVar = Var::make("p" + modeName + "_begin", indexVar.getDataType());
+  // Positions may need more bits than coordinates
+  Datatype posType = indexVar.getDataType();
+  if (mode.getIndexType().getNumBits() > posType.getNumBits()) {
+    posType = mode.getIndexType();
+  }
+  content->posVar   = Var::make(name,            posType);
+  content->endVar   = Var::make("p" + modeName + "_end",   posType);
+  content->beginVar = Var::make("p" + modeName + "_begin", posType);
 
   content->coordVar = Var::make(name, indexVar.getDataType());
   content->segendVar = Var::make(modeName + "_segend", indexVar.getDataType());
@@ -296,6 +301,18 @@ ModeFunction Iterator::locate(const std::vector<ir::Expr>& coords) const {
                                               coords, getMode());
 }
 
+bool Iterator::hasBitset() const {
+  taco_iassert(defined());
+  if (isDimensionIterator()) return false;
+  return getMode().defined() && getBitsetWord(0).defined();
+}
+
+Expr Iterator::getBitsetWord(const Expr& word) const {
+  taco_iassert(defined() && content->mode.defined());
+  return getMode().getModeFormat().impl->getBitsetWord(getParent().getPosVar(),
+                                                       word, getMode());
+}
+
 Stmt Iterator::getInsertCoord(const Expr& p, const std::vector<Expr>& coords) const {
   taco_iassert(defined() && content->mode.defined());
   return getMode().getModeFormat().impl->getInsertCoord(p, coords, getMode());
@@ -326,7 +343,8 @@ Stmt Iterator::getInsertFinalizeLevel(const Expr& szPrev, const Expr& sz) const{
 
 Stmt Iterator::getAppendCoord(const Expr& p, const Expr& i) const {
   taco_iassert(defined() && content->mode.defined());
-  return content->mode.getModeFormat().impl->getAppendCoord(p, i, content->mode);
+  return content->mode.getModeFormat().impl->getAppendCoord(
+      getParent().getPosVar(), p, i, content->mode);
 }
 
 Stmt Iterator::getAppendEdges(const Expr& pPrev, const Expr& pBegin, 
@@ -588,9 +606,11 @@ void Iterators::createAccessIterators(Access access, Format format, Expr tensorI
     taco_iassert(modeTypePack.getModeFormats().size() > 0);
 
     int modeNumber = format.getModeOrdering()[level-1];
+    vector<Datatype> arrayTypes = {format.getCoordinateTypePos(level-1),
+                                   format.getCoordinateTypeIdx(level-1)};
     ModePack modePack(modeTypePack.getModeFormats().size(),
                       modeTypePack.getModeFormats()[0], tensorIR,
-                      modeNumber, level);
+                      modeNumber, level, arrayTypes);
 
     int pos = 0;
     for (auto& modeType : modeTypePack.getModeFormats()) {
@@ -606,7 +626,7 @@ void Iterators::createAccessIterators(Access access, Format format, Expr tensorI
         iteratorIndexVar = indexVar;
       }
       Mode mode(tensorIR, dim, level, modeType, modePack, pos,
-                parentModeType);
+                parentModeType, format.getIndexType());
 
       string name = iteratorIndexVar.getName() + tensorConcrete.getName();
       Iterator iterator(iteratorIndexVar, tensorIR, mode, parent, name, true);
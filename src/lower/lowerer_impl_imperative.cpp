@@ -85,7 +85,10 @@ static void createCapacityVars(const map<TensorVar, Expr>& tensorVars,
                                map<Expr, Expr>* capacityVars) {
   for (auto& tensorVar : tensorVars) {
     Expr tensor = tensorVar.second;
-    Expr capacityVar = Var::make(util::toString(tensor) + "_capacity", Int());
+    Datatype capacityType = tensorVar.first.getFormat().getIndexType();
+    Expr capacityVar = Var::make(util::toString(tensor) + "_capacity",
+                                 capacityType.getNumBits() > 32 ? capacityType
+                                                                : Int());
     capacityVars->insert({tensor, capacityVar});
   }
 }
@@ -342,6 +345,17 @@ LowererImplImperative::lower(IndexStmt stmt, string name,
     // getDimension extracts an Expr that holds the dimension
     // of a particular tensor mode. This Expr should be used as a loop bound
     // when iterating over the dimension of the target tensor.
+    auto getFixedModeSize = [](const TensorVar& tv, int mode) {
+      const Format& format = tv.getFormat();
+      if (format.getOrder() != tv.getOrder()) {
+        return 0;
+      }
+      const vector<int>& modeOrdering = format.getModeOrdering();
+      int level = (int)distance(modeOrdering.begin(),
+                                find(modeOrdering.begin(), modeOrdering.end(),
+                                     mode));
+      return format.getModeFormats()[level].getFixedSize();
+    };
     auto getDimension = [&](const TensorVar& tv, const Access& a, int mode) {
       // If the tensor mode is windowed, then the dimension for iteration is the bounds
       // of the window. Otherwise, it is the actual dimension of the mode.
@@ -354,6 +368,11 @@ LowererImplImperative::lower(IndexStmt stmt, string name,
         // If the mode has an index set, then the dimension is the size of
         // the index set.
         return ir::Literal::make(a.getIndexSet(mode).size());
+      } else if (getFixedModeSize(tv, mode) > 0) {
+        // Modes whose size is fixed by their format (e.g., the modes inside
+        // blocks) get constant loop bounds, so the loops over them can be
+        // fully unrolled by the backend compiler.
+        return ir::Literal::make(getFixedModeSize(tv, mode));
       } else {
         return GetProperty::make(tensorVars.at(tv), TensorProperty::Dimension, mode);
       }
@@ -378,7 +397,10 @@ LowererImplImperative::lower(IndexStmt stmt, string name,
           int loc = (int)distance(indexVars.begin(),
                                   find(indexVars.begin(),indexVars.end(),
                                        indexVar));
-          if(!util::contains(temporariesSet, n->tensorVar)) {
+          // Keep constant bounds from modes whose size is fixed by their
+          // format, so that the loops over blocks have constant trip counts
+          if(!util::contains(temporariesSet, n->tensorVar) &&
+             !(dimension.defined() && isa<ir::Literal>(dimension))) {
             dimension = getDimension(n->tensorVar, Access(n), loc);
           }
         }
@@ -862,6 +884,20 @@ Stmt LowererImplImperative::lowerForall(Forall forall)
       canAccelWithSparseIteration &= indexListsExist;
     }
 
+    // Bitmap locators that are intersected can be co-iterated a word at a
+    // time.  Words may be visited in parallel unless coordinates are appended.
+    vector<Iterator> bitsets;
+    if (iterator.isDimensionIterator() && caseLattice.points().size() == 1 &&
+        (forall.getParallelUnit() == ParallelUnit::NotParallel ||
+         (forall.getParallelUnit() == ParallelUnit::CPUThread &&
+          appenders.empty())) &&
+        !should_use_CUDA_codegen() && forall.getUnrollFactor() == 0 &&
+        provGraph.isUnderived(forall.getIndexVar())) {
+      bitsets = filter(point.locators(), [](Iterator it) {
+        return it.hasBitset() && !it.isWindowed() && !it.hasIndexSet();
+      });
+    }
+
     if (!isWhereProducer && hasPosDescendant && underivedAncestors.size() > 1 && provGraph.isPosVariable(iterator.getIndexVar()) && posDescendant == forall.getIndexVar()) {
       loops = lowerForallFusedPosition(forall, iterator, locators, inserters, appenders, caseLattice,
                                        reducedAccesses, recoveryStmt);
@@ -869,6 +905,12 @@ Stmt LowererImplImperative::lowerForall(Forall forall)
     else if (canAccelWithSparseIteration) {
       loops = lowerForallDenseAcceleration(forall, locators, inserters, appenders, caseLattice, reducedAccesses, recoveryStmt);
     }
+    // Emit loop over the words of intersected bitsets
+    else if (!bitsets.empty()) {
+      loops = lowerForallBitset(forall, bitsets, point.locators(), inserters,
+                                appenders, caseLattice, reducedAccesses,
+                                recoveryStmt);
+    }
     // Emit dimension coordinate iteration loop
     else if (iterator.isDimensionIterator()) {
       loops = lowerForallDimension(forall, point.locators(), inserters, appenders, caseLattice,
@@ -1249,6 +1291,74 @@ Stmt LowererImplImperative::lowerForallDimension(Forall forall,
                        posAppend);
 }
 
+Stmt LowererImplImperative::lowerForallBitset(Forall forall,
+                                              vector<Iterator> bitsets,
+                                              vector<Iterator> locators,
+                                              vector<Iterator> inserters,
+                                              vector<Iterator> appenders,
+                                              MergeLattice caseLattice,
+                                              set<Access> reducedAccesses,
+                                              ir::Stmt recoveryStmt)
+{
+  Expr coordinate = getCoordinateVar(forall.getIndexVar());
+
+  if (forall.getParallelUnit() != ParallelUnit::NotParallel && forall.getOutputRaceStrategy() == OutputRaceStrategy::Atomics) {
+    markAssignsAtomicDepth++;
+    atomicParallelUnit = forall.getParallelUnit();
+  }
+
+  // Coordinates are only visited if every bitset stores them, so the body
+  // need not check whether locating into the bitsets finds them
+  bitsetIterators.insert(bitsets.begin(), bitsets.end());
+  Stmt body = lowerForallBody(coordinate, forall.getStmt(), locators, inserters,
+                              appenders, caseLattice, reducedAccesses,
+                              forall.getMergeStrategy());
+  for (const Iterator& bitset : bitsets) {
+    bitsetIterators.erase(bitset);
+  }
+
+  if (forall.getParallelUnit() != ParallelUnit::NotParallel && forall.getOutputRaceStrategy() == OutputRaceStrategy::Atomics) {
+    markAssignsAtomicDepth--;
+  }
+  body = Block::make({recoveryStmt, body});
+
+  Stmt posAppend = generateAppendPositions(appenders);
+
+  std::vector<ir::Expr> bounds = provGraph.deriveIterBounds(forall.getIndexVar(), definedIndexVarsOrdered, underivedBounds, indexVarToExprMap, iterators);
+
+  // Intersect the bitsets a word at a time and visit the set bits in order
+  Expr word = Var::make(coordinate.as<Var>()->name + "_word", coordinate.type());
+  Expr bits = Var::make(coordinate.as<Var>()->name + "_bits", UInt64);
+  vector<Expr> bitsetWords;
+  for (const Iterator& bitset : bitsets) {
+    bitsetWords.push_back(bitset.getBitsetWord(word));
+  }
+  Expr intersection = bitsetWords[0];
+  for (size_t i = 1; i < bitsetWords.size(); i++) {
+    intersection = BitAnd::make(intersection, bitsetWords[i]);
+  }
+
+  Expr firstBit = ir::Call::make("taco_bitmapFirst", {bits}, coordinate.type());
+  Stmt declCoordinate = VarDecl::make(coordinate,
+                                      ir::Add::make(ir::Mul::make(word, 64),
+                                                    firstBit));
+  Stmt clearBit = Assign::make(bits, ir::Call::make("taco_bitmapNext", {bits},
+                                                UInt64));
+  Stmt visitBits = While::make(Neq::make(bits, ir::Literal::zero(UInt64)),
+                               Block::make(declCoordinate, clearBit, body));
+  Expr numWords = ir::Div::make(ir::Add::make(bounds[1], 63), 64);
+  LoopKind kind = LoopKind::Serial;
+  if (forall.getParallelUnit() != ParallelUnit::NotParallel
+      && forall.getOutputRaceStrategy() != OutputRaceStrategy::ParallelReduction) {
+    kind = LoopKind::Runtime;
+  }
+  Stmt loop = For::make(word, 0, numWords, 1,
+                        Block::make(VarDecl::make(bits, intersection),
+                                    visitBits),
+                        kind, forall.getParallelUnit());
+  return Block::blanks(loop, posAppend);
+}
+
   Stmt LowererImplImperative::lowerForallDenseAcceleration(Forall forall,
                                                  vector<Iterator> locators,
                                                  vector<Iterator> inserters,
@@ -1331,9 +1441,16 @@ Stmt LowererImplImperative::lowerForallPosition(Forall forall, Iterator iterator
   Stmt declareCoordinate = Stmt();
   Stmt strideGuard = Stmt();
   Stmt boundsGuard = Stmt();
+  Stmt emptyGuard = Stmt();
   if (provGraph.isCoordVariable(forall.getIndexVar())) {
-    Expr coordinateArray = iterator.posAccess(iterator.getPosVar(),
-                                              coordinates(iterator)).getResults()[0];
+    ModeFunction posAccess = iterator.posAccess(iterator.getPosVar(),
+                                                coordinates(iterator));
+    Expr coordinateArray = posAccess.getResults()[0];
+    // Skip positions that hold no coordinate (e.g., empty hash table slots)
+    if (!isValue(posAccess.getResults()[1], true)) {
+      emptyGuard = IfThenElse::make(ir::Eq::make(posAccess.getResults()[1], false),
+                                    ir::Continue::make());
+    }
     // If the iterator is windowed, we must recover the coordinate index
     // variable from the windowed space.
     if (iterator.isWindowed()) {
@@ -1409,7 +1526,8 @@ Stmt LowererImplImperative::lowerForallPosition(Forall forall, Iterator iterator
     endBound = endBounds[1];
   }
 
-  Stmt loop = Block::make(strideGuard, declareCoordinate, boundsGuard, body);
+  Stmt loop = Block::make(emptyGuard, strideGuard, declareCoordinate,
+                          boundsGuard, body);
   if (iterator.isBranchless() && iterator.isCompact() && 
       (iterator.getParent().isRoot() || iterator.getParent().isUnique())) {
     loop = Block::make(VarDecl::make(iterator.getPosVar(), startBound), loop);
@@ -1635,11 +1753,83 @@ Stmt LowererImplImperative::lowerMergeLattice(MergeLattice caseLattice, IndexVar
   // Append position to the pos array
   Stmt appendPositions = generateAppendPositions(appenders);
 
+  if (mergestrategy == MergeStrategy::MergePath && appenders.empty() &&
+      inParallelLoopDepth == 0 && !should_use_CUDA_codegen()) {
+    Stmt partitions = lowerMergePathPartitions(loopLattice, coordinateVar,
+                                               iteratorVarInits, mergeLoops);
+    if (partitions.defined()) {
+      return partitions;
+    }
+  }
+
   return Block::blanks(iteratorVarInits,
                        mergeLoops,
                        appendPositions);
 }
 
+Stmt LowererImplImperative::lowerMergePathPartitions(MergeLattice lattice,
+                                                     IndexVar coordinateVar,
+                                                     Stmt iteratorVarInits,
+                                                     Stmt mergeLoops) {
+  // Merge paths are split between the coordinate arrays of two compressed
+  // iterators
+  vector<Iterator> iterators = lattice.iterators();
+  if (iterators.size() != 2 ||
+      !all(iterators, [](Iterator it) {
+        return it.isModeIterator() && it.hasPosIter() && it.isUnique() &&
+               it.isOrdered() && !it.isWindowed() && !it.hasIndexSet() &&
+               it.getMode().getModeFormat().getName() == Compressed.getName() &&
+               (it.getParent().isRoot() || it.getParent().isUnique());
+      })) {
+    return Stmt();
+  }
+
+  string name = getCoordinateVar(coordinateVar).as<Var>()->name;
+  Expr partition = Var::make(name + "_partition", Int());
+  Expr numPartitions = Var::make(name + "_partitions", Int());
+  Expr beginCoord = Var::make(name + "_partition_begin", Int());
+  Expr endCoord = Var::make(name + "_partition_end", Int());
+
+  vector<Expr> crds;
+  for (const Iterator& iterator : iterators) {
+    crds.push_back(iterator.getMode().getModePack().getArray(1));
+  }
+  auto mergePathCoordinate = [&](Expr partition) {
+    vector<Expr> args = {crds[0], iterators[0].getIteratorVar(),
+                         iterators[0].getEndVar(),
+                         crds[1], iterators[1].getIteratorVar(),
+                         iterators[1].getEndVar(),
+                         partition, numPartitions};
+    return ir::Call::make("taco_mergePathCoordinate", args, Int());
+  };
+
+  // Restrict each iterator to the coordinates in the partition
+  vector<Stmt> restrictIterators;
+  restrictIterators.push_back(VarDecl::make(beginCoord,
+                                            mergePathCoordinate(partition)));
+  restrictIterators.push_back(VarDecl::make(endCoord,
+      mergePathCoordinate(ir::Add::make(partition, 1))));
+  for (size_t i = 0; i < iterators.size(); i++) {
+    Expr iterVar = iterators[i].getIteratorVar();
+    Expr endVar = iterators[i].getEndVar();
+    vector<Expr> endArgs = {crds[i], iterVar, endVar, endCoord};
+    vector<Expr> beginArgs = {crds[i], iterVar, endVar, beginCoord};
+    restrictIterators.push_back(Assign::make(endVar,
+        ir::Call::make("taco_lowerBound", endArgs, endVar.type())));
+    restrictIterators.push_back(Assign::make(iterVar,
+        ir::Call::make("taco_lowerBound", beginArgs, iterVar.type())));
+  }
+
+  Stmt body = Block::make(iteratorVarInits, Block::make(restrictIterators),
+                          mergeLoops);
+  Stmt loop = For::make(partition, 0, numPartitions, 1, body, LoopKind::Dynamic,
+                        ParallelUnit::CPUThread);
+  return Block::make(VarDecl::make(numPartitions,
+                                   ir::Call::make("taco_mergePathPartitions",
+                                                  {}, Int())),
+                     loop);
+}
+
 Stmt LowererImplImperative::lowerMergePoint(MergeLattice pointLattice,
                                   ir::Expr coordinate, IndexVar coordinateVar, IndexStmt statement,
                                   const std::set<Access>& reducedAccesses, bool resolvedCoordDeclared, 
@@ -1721,7 +1911,8 @@ Stmt LowererImplImperative::lowerMergePoint(MergeLattice pointLattice,
 
   // Merge iterator coordinate variables
   bool mergeWithMax;
-  if (mergeStrategy == MergeStrategy::Gallop) {
+  if (mergeStrategy == MergeStrategy::Gallop ||
+      mergeStrategy == MergeStrategy::SIMDBlock) {
     mergeWithMax = true;
   } else {
     mergeWithMax = false;
@@ -1742,6 +1933,28 @@ Stmt LowererImplImperative::lowerMergePoint(MergeLattice pointLattice,
   Stmt caseStmts = lowerMergeCases(coordinate, coordinateVar, statement, pointLattice,
                                    reducedAccesses, mergeStrategy);
 
+  // Skip coordinates that are not stored by intersected locators whose locate
+  // can miss (e.g., bitmap modes)
+  vector<Expr> found;
+  for (const Iterator& locator : locators) {
+    if (!util::contains(locateFoundExprs, locator)) {
+      continue;
+    }
+    if (util::all(pointLattice.points(), [&](const MergePoint& lp) {
+          return util::contains(lp.locators(), locator);
+        })) {
+      found.push_back(locateFoundExprs.at(locator));
+    } else {
+      taco_uassert(pointLattice.anyModeIteratorIsLeaf() &&
+                   pointLattice.needExplicitZeroChecks())
+          << "Unions with bitmap modes are only supported at the bottom level "
+          << "of tensors";
+    }
+  }
+  if (!found.empty()) {
+    caseStmts = IfThenElse::make(conjunction(found), caseStmts);
+  }
+
   // Increment iterator position variables
   Stmt incIteratorVarStmts = codeToIncIteratorVars(coordinate, coordinateVar, iterators, mergers, mergeStrategy);
 
@@ -1895,7 +2108,20 @@ Stmt LowererImplImperative::lowerMergeCases(ir::Expr coordinate, IndexVar coordi
 ir::Expr LowererImplImperative::constructCheckForAccessZero(Access access) {
   Expr tensorValue = lower(access);
   IndexExpr zeroVal = Literal::zero(tensorValue.type()); //TODO ARRAY Generalize
-  return Neq::make(tensorValue, lower(zeroVal));
+  Expr isNonZero = Neq::make(tensorValue, lower(zeroVal));
+
+  // Only load values at positions of coordinates that are stored
+  vector<Expr> found;
+  for (const Iterator& iterator : getIterators(access)) {
+    if (util::contains(locateFoundExprs, iterator)) {
+      found.push_back(locateFoundExprs.at(iterator));
+    }
+  }
+  if (found.empty()) {
+    return isNonZero;
+  }
+  found.push_back(isNonZero);
+  return conjunction(found);
 }
 
 std::vector<Iterator> LowererImplImperative::getModeIterators(const std::vector<Iterator>& iters) {
@@ -2035,7 +2261,10 @@ vector<Stmt> LowererImplImperative::lowerCasesFromMap(map<Iterator, Expr> iterat
     cases.push_back({Expr((bool) true), backgroundInit});
     result.push_back(Case::make(cases, true));
   } else {
-    result.push_back(Case::make(cases, lattice.exact()));
+    // The last case must still check its operands if they are located in
+    // modes that may not store the coordinate
+    result.push_back(Case::make(cases, lattice.exact() &&
+                                       !lattice.anyLocatorMayMiss()));
   }
   return result;
 }
@@ -2080,6 +2309,10 @@ Stmt LowererImplImperative::lowerForallBody(Expr coordinate, IndexStmt stmt,
   // Inserter positions
   Stmt declInserterPosVars = declLocatePosVars(inserters);
 
+  // Code to insert coordinates into inserters that store them
+  Stmt insertCoords = generateAssembleCode() ? insertCoordinates(inserters)
+                                             : Stmt();
+
   // Locate positions
   Stmt declLocatorPosVars = declLocatePosVars(locators);
 
@@ -2113,8 +2346,22 @@ Stmt LowererImplImperative::lowerForallBody(Expr coordinate, IndexStmt stmt,
     append(stmts, loweredCases);
     Stmt body = Block::make(stmts);
 
-    return Block::make(declInserterPosVars, declLocatorPosVars, body);
+    return Block::make(declInserterPosVars, insertCoords, declLocatorPosVars,
+                       body);
+  }
+
+  // Locators whose locate can miss (e.g., bitmap modes) must store the
+  // coordinate, since the lattice point intersects them
+  vector<Expr> found;
+  for (const Iterator& locator : locators) {
+    if (util::contains(locateFoundExprs, locator) &&
+        !util::contains(bitsetIterators, locator)) {
+      found.push_back(locateFoundExprs.at(locator));
+    }
   }
+  taco_uassert(found.empty() || caseLattice.points().size() <= 1)
+      << "Unions with bitmap modes are only supported at the bottom level "
+      << "of tensors";
 
   Stmt initVals = resizeAndInitValues(appenders, reducedAccesses);
 
@@ -2124,10 +2371,20 @@ Stmt LowererImplImperative::lowerForallBody(Expr coordinate, IndexStmt stmt,
   // Code to append coordinate
   Stmt appendCoords = appendCoordinate(appenders, coordinate);
 
+  if (!found.empty()) {
+    Expr isStored = conjunction(found);
+    body = IfThenElse::make(isStored, Block::make(insertCoords, body,
+                                                  appendCoords));
+    insertCoords = Stmt();
+    appendCoords = Stmt();
+  }
+
   std::vector<Stmt> stmts;
   
   // Code to increment iterators when merging by galloping.
-  if (mergeStrategy == MergeStrategy::Gallop && caseLattice.iterators().size() > 1) {
+  if ((mergeStrategy == MergeStrategy::Gallop ||
+       mergeStrategy == MergeStrategy::SIMDBlock) &&
+      caseLattice.iterators().size() > 1) {
     for (auto it : caseLattice.iterators()) {
       Expr ivar = it.getIteratorVar();
       stmts.push_back(compoundAssign(ivar, 1));
@@ -2136,10 +2393,9 @@ Stmt LowererImplImperative::lowerForallBody(Expr coordinate, IndexStmt stmt,
 
   Stmt incr = Block::make(stmts);
 
-  // TODO: Emit code to insert coordinates
-
   return Block::make(initVals,
                      declInserterPosVars,
+                     insertCoords,
                      declLocatorPosVars,
                      body,
                      appendCoords,
@@ -2743,11 +2999,54 @@ Expr LowererImplImperative::getTemporarySize(TensorVar var){
 
 }
 
+/// Returns the temporaries of a dimension reduction that are only used within
+/// the iterations of a loop of its producer that is parallelized over CPU
+/// threads, such as the tiles gathered for and returned by interface calls.
+/// Every thread needs its own copy of them.
+static set<TensorVar> getThreadPrivateTemporaries(DimReduction dimReduction) {
+  Forall parallelForall;
+  match(dimReduction.getProducer(),
+    function<void(const ForallNode*,Matcher*)>([&](const ForallNode* op,
+                                                   Matcher* ctx) {
+      if (op->parallel_unit == ParallelUnit::CPUThread) {
+        parallelForall = op;
+      } else {
+        ctx->match(op->stmt);
+      }
+    })
+  );
+  if (!parallelForall.defined()) {
+    return {};
+  }
+
+  map<TensorVar, int> accesses;
+  match(dimReduction,
+    function<void(const AccessNode*)>([&](const AccessNode* op) {
+      accesses[op->tensorVar]++;
+    })
+  );
+  match(parallelForall.getStmt(),
+    function<void(const AccessNode*)>([&](const AccessNode* op) {
+      accesses[op->tensorVar]--;
+    })
+  );
+
+  set<TensorVar> privateTemporaries;
+  for (const auto& temporary : dimReduction.getTemporaries()) {
+    if (util::contains(accesses, temporary) && accesses.at(temporary) == 0) {
+      privateTemporaries.insert(temporary);
+    }
+  }
+  return privateTemporaries;
+}
+
 vector<vector<Stmt>> LowererImplImperative::codeToInitializeTemporary(DimReduction dimReduction){
 
   std::vector<Stmt> initializeTemps;
   std::vector<Stmt> freeTemps;
 
+  set<TensorVar> privateTemporaries = getThreadPrivateTemporaries(dimReduction);
+
   for (const auto &temporary : dimReduction.getTemporaries()){
     Stmt freeTemporary = Stmt();
     Stmt initializeTemporary = Stmt();
@@ -2757,6 +3056,13 @@ vector<vector<Stmt>> LowererImplImperative::codeToInitializeTemporary(DimReducti
       Stmt initTempSet = VarDecl::make(tempSet, false);
       initializeTemporary = Block::make(initializeTemporary, initTempSet);
       tempToBitGuard[temporary] = tempSet;
+
+      // Scalars private to each thread are declared in the parallel loop
+      if (util::contains(privateTemporaries, temporary)) {
+        threadPrivateTemporaries.erase(temporary);
+        threadPrivateTemporaries.insert({temporary, initializeTemporary});
+        initializeTemporary = Stmt();
+      }
     } else {
       // TODO: Need to support keeping track of initialized elements for
       //       temporaries that don't have sparse accelerator
@@ -2781,10 +3087,35 @@ vector<vector<Stmt>> LowererImplImperative::codeToInitializeTemporary(DimReducti
       if ((isa<Forall>(dimReduction.getProducer()) && inParallelLoopDepth == 0) || !should_use_CUDA_codegen()) {
         decl = VarDecl::make(values, ir::Literal::make(0));
       }
-      Stmt allocate = Allocate::make(values, size, false, Expr(), true);
 
-      freeTemporary = Block::make(freeTemporary, Free::make(values));
-      initializeTemporary = Block::make(decl, initializeTemporary, allocate);
+      // Temporaries that alias operand slices point into the operand, so they
+      // are neither allocated nor freed
+      if (util::contains(temporaryAliases, temporary) &&
+          util::contains(privateTemporaries, temporary)) {
+        threadPrivateTemporaries.erase(temporary);
+        threadPrivateTemporaries.insert({temporary, VarDecl::make(values, ir::Literal::make(0))});
+      } else if (util::contains(temporaryAliases, temporary)) {
+        initializeTemporary = Block::make(decl, initializeTemporary);
+      } else if (util::contains(privateTemporaries, temporary)) {
+        // Every thread uses its own part of an array that holds the
+        // temporaries of all threads
+        Expr valuesAll = ir::Var::make(temporary.getName() + "_all",
+                                       temporary.getType().getDataType(), true, false);
+        Expr sizeAll = ir::Mul::make(size, ir::Call::make("omp_get_max_threads", {}, size.type()));
+        Expr threadNum = ir::Call::make("omp_get_thread_num", {}, size.type());
+        Stmt allocate = Allocate::make(valuesAll, sizeAll, false, Expr(), true);
+
+        freeTemporary = Block::make(freeTemporary, Free::make(valuesAll));
+        initializeTemporary = Block::make(VarDecl::make(valuesAll, ir::Literal::make(0)),
+                                          initializeTemporary, allocate);
+        threadPrivateTemporaries.erase(temporary);
+        threadPrivateTemporaries.insert({temporary, VarDecl::make(values, ir::Add::make(valuesAll, ir::Mul::make(size, threadNum)))});
+      } else {
+        Stmt allocate = Allocate::make(values, size, false, Expr(), true);
+
+        freeTemporary = Block::make(freeTemporary, Free::make(values));
+        initializeTemporary = Block::make(decl, initializeTemporary, allocate);
+      }
       
 
       /// Make a struct object that lowerAssignment and lowerAccess can read
@@ -2830,6 +3161,25 @@ Stmt LowererImplImperative::lowerAssignSpecial(Assignment assignment){
 Stmt LowererImplImperative::lowerForallMany(ForallMany forallMany){
   vector<Stmt> blockToMake;
 
+  // Declare the thread-private temporaries used here, which the statements
+  // nested in this one then share
+  map<TensorVar, Stmt> enclosingPrivateTemporaries = threadPrivateTemporaries;
+  set<TensorVar> declared;
+  match(forallMany,
+    std::function<void(const AccessNode*)>([&](const AccessNode* op) {
+      if (util::contains(threadPrivateTemporaries, op->tensorVar) &&
+          !util::contains(declared, op->tensorVar)) {
+        declared.insert(op->tensorVar);
+        blockToMake.push_back(threadPrivateTemporaries.at(op->tensorVar));
+      }
+    })
+  );
+  for (const auto& temporary : declared) {
+    threadPrivateTemporaries.erase(temporary);
+  }
+
+  blockToMake.push_back(codeToBindAliasedTemporaries(forallMany));
+
   for (const auto &stmt : forallMany.getStmts()){
     if (!stmt.defined()){
       continue;
@@ -2842,6 +3192,7 @@ Stmt LowererImplImperative::lowerForallMany(ForallMany forallMany){
       blockToMake.push_back(lower(stmt));
     }
   }
+  threadPrivateTemporaries.swap(enclosingPrivateTemporaries);
   return Block::make(blockToMake);
 }
 
@@ -2849,6 +3200,11 @@ Stmt LowererImplImperative::lowerDimReduce(DimReduction dimReduction){
 
   // taco_uerror << "here" << endl;
   vector<Stmt> blockToMake;
+  map<TensorVar, Access> enclosingAliases = temporaryAliases;
+  for (const auto& alias : dimReduction.getAliases()) {
+    temporaryAliases.erase(alias.first);
+    temporaryAliases.insert(alias);
+  }
   vector<vector<Stmt>> temporaryValuesInitFree = codeToInitializeTemporary(dimReduction);
 
   if (this->compute){
@@ -2858,11 +3214,49 @@ Stmt LowererImplImperative::lowerDimReduce(DimReduction dimReduction){
     blockToMake.push_back(lower(dimReduction.getConsumer()));
     blockToMake.push_back(Block::make(temporaryValuesInitFree[1]));
   }
+  temporaryAliases.swap(enclosingAliases);
 
   return Block::make(blockToMake);
 
 }
 
+Stmt LowererImplImperative::codeToBindAliasedTemporaries(IndexStmt stmt){
+  vector<Stmt> bindings;
+  set<TensorVar> bound;
+  match(stmt,
+    std::function<void(const AccessNode*)>([&](const AccessNode* op) {
+      if (!util::contains(temporaryAliases, op->tensorVar) ||
+          util::contains(bound, op->tensorVar)) {
+        return;
+      }
+      bound.insert(op->tensorVar);
+
+      // The slice starts at the row-major position of the held coordinates,
+      // with the coordinates of the modes inside the slice set to zero
+      Access operand = temporaryAliases.at(op->tensorVar);
+      TensorVar tensor = operand.getTensorVar();
+      Expr offset;
+      for (int mode : tensor.getFormat().getModeOrdering()) {
+        IndexVar var = operand.getIndexVars()[mode];
+        if (offset.defined()) {
+          offset = ir::Mul::make(offset, GetProperty::make(getTensorVar(tensor),
+                                                           TensorProperty::Dimension,
+                                                           mode));
+        }
+        if (util::contains(definedIndexVars, var)) {
+          Expr coord = lowerIndexVar(var);
+          offset = offset.defined() ? ir::Add::make(offset, coord) : coord;
+        }
+      }
+
+      Expr values = getValuesArray(tensor);
+      Expr slice = offset.defined() ? ir::Add::make(values, offset) : values;
+      bindings.push_back(Assign::make(getValuesArray(op->tensorVar), slice));
+    })
+  );
+  return Block::make(bindings);
+}
+
 ir::Expr LowererImplImperative::lowerArgument(Argument argument, TensorVar resultVar, TensorVar temporary, std::vector<DeclVarArg>& varsToDeclare, bool replace, IndexExpr rhs){
 
     switch(argument.getArgType()){
@@ -3019,6 +3413,15 @@ ir::Expr LowererImplImperative::lowerArgument(Argument argument, TensorVar resul
 
         return CustomCast::make(lowerArgument(t->argument, resultVar, temporary, varsToDeclare, replace, rhs), t->cast);
       }
+      case DIM_PRODUCT:
+      {
+        Expr product;
+        for (const auto& indexVar : argument.getNode<DimProduct>()->indexVars){
+          Expr dim = lowerArgument(new DimArg(indexVar), resultVar, temporary, varsToDeclare, replace, rhs);
+          product = product.defined() ? ir::Mul::make(product, dim) : dim;
+        }
+        return product;
+      }
       default:
         taco_uerror << "Should not reach" << endl;
     }
@@ -3146,7 +3549,33 @@ Stmt LowererImplImperative::lowerInterface(InterfaceCall interface){
 
   loweredCode.insert(loweredCode.end(), functionCalls.begin(), functionCalls.end());
 
-  
+  IndexStmt remainder = interface.getRemainder();
+  if (remainder.defined()) {
+    // Only make the call on full tiles.  A tile of an index variable split
+    // into f1 and f2 is full if (f1 + 1) * tileSize does not exceed the
+    // bound of the variable, and partial tiles use the generated code.
+    Expr fullTile;
+    for (const auto& var : interface.getProducer().getIndexVars()) {
+      std::vector<IndexVar> parents = provGraph.getParents(var);
+      if (parents.size() != 1 || !underivedBounds.count(parents[0])) {
+        continue;
+      }
+      std::vector<IndexVar> children = provGraph.getChildren(parents[0]);
+      if (children.size() != 2 || children[1] != var ||
+          !indexVarToExprMap.count(children[0])) {
+        continue;
+      }
+      auto bounds = provGraph.deriveIterBounds(var, definedIndexVarsOrdered, underivedBounds, indexVarToExprMap, iterators);
+      Expr tileSize = ir::Sub::make(bounds[1], bounds[0]);
+      Expr tileEnd = ir::Mul::make(ir::Add::make(indexVarToExprMap[children[0]], 1), tileSize);
+      Expr isFull = ir::Lte::make(tileEnd, underivedBounds[parents[0]][1]);
+      fullTile = fullTile.defined() ? ir::And::make(fullTile, isFull) : isFull;
+    }
+    if (fullTile.defined()) {
+      return IfThenElse::make(fullTile, Block::make(loweredCode), lower(remainder));
+    }
+  }
+
   return Block::make(loweredCode);
 }
 
@@ -4002,7 +4431,7 @@ Stmt LowererImplImperative::resizeAndInitValues(const std::vector<Iterator>& app
     Expr tensor = appender.getTensor();
     Expr values = GetProperty::make(tensor, TensorProperty::Values);
     Expr capacity = getCapacityVar(appender.getTensor());
-    Expr pos = appender.getIteratorVar();
+    Expr pos = appender.getPosVar();
 
     if (generateAssembleCode()) {
       result.push_back(doubleSizeIfFull(values, capacity, pos));
@@ -4036,6 +4465,17 @@ Stmt LowererImplImperative::initValues(Expr tensor, Expr initVal, Expr begin, Ex
   return For::make(p, lower, upper, 1, zeroInit, parallel);
 }
 
+Stmt LowererImplImperative::insertCoordinates(vector<Iterator> inserters) {
+  vector<Stmt> result;
+  for (Iterator& inserter : inserters) {
+    if (inserter.hasInsertCoord()) {
+      result.push_back(inserter.getInsertCoord(inserter.getPosVar(),
+                                               coordinates(inserter)));
+    }
+  }
+  return result.empty() ? Stmt() : Block::make(result);
+}
+
 Stmt LowererImplImperative::declLocatePosVars(vector<Iterator> locators) {
   vector<Stmt> result;
   for (Iterator& locator : locators) {
@@ -4052,7 +4492,7 @@ Stmt LowererImplImperative::declLocatePosVars(vector<Iterator> locators) {
 
     if (doLocate) {
       Iterator locateIterator = locator;
-      if (locateIterator.hasPosIter()) {
+      if (locateIterator.hasPosIter() && !locateIterator.hasLocate()) {
         taco_iassert(!provGraph.isUnderived(locateIterator.getIndexVar()));
         continue; // these will be recovered with separate procedure
       }
@@ -4073,7 +4513,17 @@ Stmt LowererImplImperative::declLocatePosVars(vector<Iterator> locators) {
           coords[coords.size() - 1] = coordArray;
         }
         ModeFunction locate = locateIterator.locate(coords);
-        taco_iassert(isValue(locate.getResults()[1], true));
+        // Modes that support insertion (e.g., hashed modes) locate absent
+        // coordinates at empty positions, which hold the fill value.  Other
+        // modes whose locate can miss (e.g., bitmap modes) report whether the
+        // coordinate is stored, and code that reads them checks it.
+        if (!isValue(locate.getResults()[1], true) &&
+            !locateIterator.hasInsert()) {
+          locateFoundExprs[locateIterator] = locate.getResults()[1];
+        }
+        if (locate.compute().defined()) {
+          result.push_back(locate.compute());
+        }
         Stmt declarePosVar = VarDecl::make(locateIterator.getPosVar(),
                                            locate.getResults()[0]);
         result.push_back(declarePosVar);
@@ -4317,7 +4767,8 @@ Stmt LowererImplImperative::codeToIncIteratorVars(Expr coordinate, IndexVar coor
       if (iterator.isFull()) {
         Expr increment = 1;
         result.push_back(compoundAssign(ivar, increment));
-      } else if (strategy == MergeStrategy::Gallop) {
+      } else if (strategy == MergeStrategy::Gallop ||
+                 strategy == MergeStrategy::SIMDBlock) {
         Expr iteratorParentPos = iterator.getParent().getPosVar();
         ModeFunction iterBounds = iterator.posBounds(iteratorParentPos);
         result.push_back(iterBounds.compute());
@@ -4326,7 +4777,9 @@ Stmt LowererImplImperative::codeToIncIteratorVars(Expr coordinate, IndexVar coor
           ivar, iterBounds[1],
           coordinate,
         };
-        result.push_back(ir::Assign::make(ivar, ir::Call::make("taco_gallop", gallopArgs, ivar.type())));
+        string advance = (strategy == MergeStrategy::Gallop)
+                         ? "taco_gallop" : "taco_blockAdvance";
+        result.push_back(ir::Assign::make(ivar, ir::Call::make(advance, gallopArgs, ivar.type())));
       } else { // strategy == MergeStrategy::TwoFinger
         Expr increment = ir::Cast::make(Eq::make(iterator.getCoordVar(), coordinate), ivar.type());
         result.push_back(compoundAssign(ivar, increment));
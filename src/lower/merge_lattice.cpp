@@ -1093,7 +1093,10 @@ MergeLattice MergeLattice::make(Forall forall, Iterators iterators, ProvenanceGr
   MergeLattice lattice = builder.build(forall.getStmt());
 
   // Can't remove points if lattice contains omitters since we lose merge cases during lowering.
-  if(lattice.anyModeIteratorIsLeaf() && lattice.needExplicitZeroChecks()) {
+  // Nor if operands of unions are located in modes that may not store the
+  // coordinate, since each case must then check which operands store it.
+  if((lattice.anyModeIteratorIsLeaf() || lattice.anyLocatorMayMiss()) &&
+     lattice.needExplicitZeroChecks()) {
     return lattice;
   }
 
@@ -1145,9 +1148,23 @@ bool MergeLattice::needExplicitZeroChecks() {
   if(util::any(points(), [](const MergePoint& mp) {return mp.isOmitter();})) {
     return true;
   }
+  if (points().size() > 1 && anyLocatorMayMiss()) {
+    return true;
+  }
   return !getTensorRegionsToKeep().empty();
 }
 
+bool MergeLattice::anyLocatorMayMiss() const {
+  // Locating a coordinate in a mode that neither stores every coordinate nor
+  // supports insertion (e.g., a bitmap mode) may find that it is not stored
+  return util::any(points(), [](const MergePoint& mp) {
+    return util::any(mp.locators(), [](const Iterator& it) {
+      return it.isModeIterator() && !it.isFull() && it.hasLocate() &&
+             !it.hasInsert();
+    });
+  });
+}
+
 MergeLattice MergeLattice::subLattice(MergePoint lp) const {
   // A merge point lp dominats lq iff it contains a subset of lp's
   // tensor path steps. So we scan through the points and filter those points.
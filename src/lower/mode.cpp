@@ -22,6 +22,8 @@ struct Mode::Content {
 
   ModeFormat parentModeFormat;  /// type of previous mode in the tensor
 
+  Datatype   indexType;         /// type of positions in the mode
+
   std::map<std::string, ir::Expr> vars;
 };
 
@@ -29,7 +31,8 @@ Mode::Mode() : content(nullptr) {
 }
 
 Mode::Mode(ir::Expr tensor, Dimension size, int mode, ModeFormat modeFormat,
-     ModePack modePack, size_t packLoc, ModeFormat parentModeFormat)
+     ModePack modePack, size_t packLoc, ModeFormat parentModeFormat,
+     Datatype indexType)
     : content(new Content) {
   taco_iassert(modeFormat.defined());
   content->tensor = tensor;
@@ -39,6 +42,7 @@ Mode::Mode(ir::Expr tensor, Dimension size, int mode, ModeFormat modeFormat,
   content->modePack = modePack;
   content->packLoc = packLoc;
   content->parentModeFormat = parentModeFormat;
+  content->indexType = indexType;
 }
 
 std::string Mode::getName() const {
@@ -73,6 +77,10 @@ ModeFormat Mode::getParentModeType() const {
   return content->parentModeFormat;
 }
 
+Datatype Mode::getIndexType() const {
+  return content->indexType;
+}
+
 ir::Expr Mode::getVar(std::string varName) const {
   taco_iassert(hasVar(varName));
   return content->vars.at(varName);
@@ -106,9 +114,25 @@ ModePack::ModePack() : content(new Content) {
 }
 
 ModePack::ModePack(size_t numModes, ModeFormat modeType, ir::Expr tensor,
-                   int mode, int level) : ModePack() {
+                   int mode, int level, const std::vector<Datatype>& arrayTypes)
+    : ModePack() {
   content->numModes = numModes;
   content->arrays = modeType.impl->getArrays(tensor, mode, level);
+
+  // Mode formats create their index arrays as Int32 arrays, unless the
+  // format fixes the type of an array (e.g., the words of bitmap modes)
+  for (auto& array : content->arrays) {
+    const ir::GetProperty* property = array.as<ir::GetProperty>();
+    if (property != nullptr &&
+        property->property == ir::TensorProperty::Indices &&
+        property->type == Int32 &&
+        (size_t)property->index < arrayTypes.size() &&
+        arrayTypes[property->index] != property->type) {
+      array = ir::GetProperty::make(property->tensor, property->property,
+                                    property->mode, property->index,
+                                    property->name, arrayTypes[property->index]);
+    }
+  }
 }
 
 size_t ModePack::getNumModes() const {
@@ -0,0 +1,132 @@
+#include "taco/lower/mode_format_bitmap.h"
+
+#include "taco/ir/ir_generators.h"
+#include "taco/util/strings.h"
+
+using namespace std;
+using namespace taco::ir;
+
+namespace taco {
+
+BitmapModeFormat::BitmapModeFormat() : BitmapModeFormat(false) {
+}
+
+BitmapModeFormat::BitmapModeFormat(bool isZeroless) :
+    ModeFormatImpl("bitmap", false, true, true, false, true, isZeroless,
+                   false, false, false, true, false, true, false, false,
+                   true) {
+}
+
+ModeFormat BitmapModeFormat::copy(
+    vector<ModeFormat::Property> properties) const {
+  bool isZeroless = this->isZeroless;
+  for (const auto property : properties) {
+    switch (property) {
+      case ModeFormat::ZEROLESS:
+        isZeroless = true;
+        break;
+      case ModeFormat::NOT_ZEROLESS:
+        isZeroless = false;
+        break;
+      default:
+        break;
+    }
+  }
+  return ModeFormat(std::make_shared<BitmapModeFormat>(isZeroless));
+}
+
+ModeFunction BitmapModeFormat::locate(Expr parentPos,
+                                      std::vector<Expr> coords,
+                                      Mode mode) const {
+  Expr coord = coords.back();
+  Expr wordPos = ir::Add::make(ir::Mul::make(parentPos, getNumWords(mode)),
+                               ir::Div::make(coord, 64));
+  Expr word = Load::make(getBitsArray(mode.getModePack()), wordPos);
+  Expr rank = ir::Call::make("taco_bitmapRank", {word, coord}, mode.getIndexType());
+  Expr pos = ir::Add::make(Load::make(getPosArray(mode.getModePack()), wordPos),
+                           rank);
+  Expr found = ir::Call::make("taco_bitmapTest", {word, coord}, Bool);
+  return ModeFunction(Stmt(), {pos, found});
+}
+
+Stmt BitmapModeFormat::getAppendCoord(Expr parentPos, Expr pos, Expr coord,
+                                      Mode mode) const {
+  Expr bitsArray = getBitsArray(mode.getModePack());
+  Expr wordPos = ir::Add::make(ir::Mul::make(parentPos, getNumWords(mode)),
+                               ir::Div::make(coord, 64));
+  Expr word = Load::make(bitsArray, wordPos);
+  return Store::make(bitsArray, wordPos,
+                     ir::Call::make("taco_bitmapSet", {word, coord}, UInt64));
+}
+
+Expr BitmapModeFormat::getSize(Expr parentSize, Mode mode) const {
+  Expr numWords = ir::Mul::make(parentSize, getNumWords(mode));
+  return Load::make(getPosArray(mode.getModePack()), numWords);
+}
+
+Stmt BitmapModeFormat::getAppendInitLevel(Expr parentSize, Expr size,
+                                          Mode mode) const {
+  // Bitsets are allocated up front, one per parent position, so the number of
+  // parent positions must be known before coordinates are appended
+  ModeFormat parentModeType = mode.getParentModeType();
+  taco_uassert(!parentModeType.defined() || !parentModeType.hasAppend())
+      << "Bitmap modes can only be assembled below modes of known size, "
+      << "such as dense modes";
+
+  Expr numWords = ir::Mul::make(parentSize, getNumWords(mode));
+  return Allocate::make(getBitsArray(mode.getModePack()), numWords, false,
+                        Expr(), true);
+}
+
+Stmt BitmapModeFormat::getAppendFinalizeLevel(Expr parentSize, Expr size,
+                                              Mode mode) const {
+  // Count the coordinates stored before each word
+  Expr posArray = getPosArray(mode.getModePack());
+  Expr bitsArray = getBitsArray(mode.getModePack());
+  Expr numWords = ir::Mul::make(parentSize, getNumWords(mode));
+
+  Expr wVar = Var::make("w" + mode.getName(), mode.getIndexType());
+  Expr count = ir::Call::make("taco_bitmapCount", {Load::make(bitsArray, wVar)},
+                          mode.getIndexType());
+  Stmt updatePos = Store::make(posArray, ir::Add::make(wVar, 1),
+                               ir::Add::make(Load::make(posArray, wVar), count));
+  return Block::make(Allocate::make(posArray, ir::Add::make(numWords, 1)),
+                     Store::make(posArray, 0, 0),
+                     For::make(wVar, 0, numWords, 1, updatePos));
+}
+
+vector<Expr> BitmapModeFormat::getArrays(Expr tensor, int mode,
+                                         int level) const {
+  std::string arraysName = util::toString(tensor) + std::to_string(level);
+  return {GetProperty::make(tensor, TensorProperty::Dimension, mode),
+          GetProperty::make(tensor, TensorProperty::Indices,
+                            level - 1, 0, arraysName + "_pos"),
+          GetProperty::make(tensor, TensorProperty::Indices,
+                            level - 1, 1, arraysName + "_bits", UInt64)};
+}
+
+Expr BitmapModeFormat::getBitsetWord(Expr parentPos, Expr word,
+                                     Mode mode) const {
+  Expr wordPos = ir::Add::make(ir::Mul::make(parentPos, getNumWords(mode)),
+                               word);
+  return Load::make(getBitsArray(mode.getModePack()), wordPos);
+}
+
+Expr BitmapModeFormat::getSizeArray(ModePack pack) const {
+  return pack.getArray(0);
+}
+
+Expr BitmapModeFormat::getPosArray(ModePack pack) const {
+  return pack.getArray(1);
+}
+
+Expr BitmapModeFormat::getBitsArray(ModePack pack) const {
+  return pack.getArray(2);
+}
+
+Expr BitmapModeFormat::getNumWords(Mode mode) const {
+  Expr size = getSizeArray(mode.getModePack());
+  return ir::Div::make(ir::Add::make(size, 63), 64);
+}
+
+}
@@ -0,0 +1,44 @@
+#include "taco/lower/mode_format_block.h"
+
+#include "taco/error.h"
+
+using namespace std;
+using namespace taco::ir;
+
+namespace taco {
+
+BlockModeFormat::BlockModeFormat(int blockSize)
+    : BlockModeFormat(blockSize, true, true, false) {
+}
+
+BlockModeFormat::BlockModeFormat(int blockSize, const bool isOrdered,
+                                 const bool isUnique, const bool isZeroless)
+    : DenseModeFormat(isOrdered, isUnique, isZeroless), blockSize(blockSize) {
+  taco_uassert(blockSize > 0) << "Block size must be positive";
+}
+
+ModeFormat BlockModeFormat::copy(
+    std::vector<ModeFormat::Property> properties) const {
+  ModeFormat dense = DenseModeFormat::copy(properties);
+  return ModeFormat(std::make_shared<BlockModeFormat>(blockSize,
+      dense.isOrdered(), dense.isUnique(), dense.isZeroless()));
+}
+
+Expr BlockModeFormat::getWidth(Mode mode) const {
+  taco_uassert(!mode.getSize().isFixed() ||
+               mode.getSize().getSize() == (size_t)blockSize)
+      << "A mode of size " << mode.getSize().getSize() << " cannot be stored "
+      << "in blocks of size " << blockSize;
+  return ir::Literal::make(blockSize);
+}
+
+int BlockModeFormat::getFixedSize() const {
+  return blockSize;
+}
+
+bool BlockModeFormat::equals(const ModeFormatImpl& other) const {
+  return ModeFormatImpl::equals(other) &&
+         (dynamic_cast<const BlockModeFormat&>(other).blockSize == blockSize);
+}
+
+}
@@ -0,0 +1,161 @@
+#include "taco/lower/mode_format_hashed.h"
+
+#include "taco/ir/ir_generators.h"
+#include "taco/util/strings.h"
+
+using namespace std;
+using namespace taco::ir;
+
+namespace taco {
+
+HashedModeFormat::HashedModeFormat() : HashedModeFormat(0) {
+}
+
+HashedModeFormat::HashedModeFormat(int tableSize) :
+    HashedModeFormat(false, tableSize) {
+}
+
+HashedModeFormat::HashedModeFormat(bool isZeroless, int tableSize) :
+    ModeFormatImpl("hashed", false, false, true, false, false, isZeroless,
+                   false, false, true, true, true, false, false, true, false),
+    tableSize(tableSize) {
+  taco_uassert(tableSize >= 0) << "Hash table size cannot be negative";
+}
+
+ModeFormat HashedModeFormat::copy(
+    vector<ModeFormat::Property> properties) const {
+  bool isZeroless = this->isZeroless;
+  for (const auto property : properties) {
+    switch (property) {
+      case ModeFormat::ZEROLESS:
+        isZeroless = true;
+        break;
+      case ModeFormat::NOT_ZEROLESS:
+        isZeroless = false;
+        break;
+      default:
+        break;
+    }
+  }
+  return ModeFormat(
+      std::make_shared<HashedModeFormat>(isZeroless, tableSize));
+}
+
+ModeFunction HashedModeFormat::posIterBounds(Expr parentPos, Mode mode) const {
+  Expr width = getWidth(mode);
+  Expr pbegin = ir::Mul::make(parentPos, width);
+  Expr pend = ir::Mul::make(ir::Add::make(parentPos, 1), width);
+  return ModeFunction(Stmt(), {pbegin, pend});
+}
+
+ModeFunction HashedModeFormat::posIterAccess(Expr pos,
+                                             std::vector<Expr> coords,
+                                             Mode mode) const {
+  Expr idx = Load::make(getCoordArray(mode.getModePack()), pos);
+  return ModeFunction(Stmt(), {idx, Neq::make(idx, -1)});
+}
+
+ModeFunction HashedModeFormat::locate(Expr parentPos,
+                                      std::vector<Expr> coords,
+                                      Mode mode) const {
+  // Probe linearly from the slot the coordinate hashes to, until reaching
+  // the coordinate or an empty slot.  A table holds at most as many
+  // coordinates as it has slots, so probing stops within one round.
+  Expr width = getWidth(mode);
+  Expr crdArray = getCoordArray(mode.getModePack());
+  Expr coord = coords.back();
+  Expr base = ir::Mul::make(parentPos, width);
+  Expr slot = Var::make(mode.getName() + "_slot", mode.getIndexType());
+  Expr slotCoord = Load::make(crdArray, ir::Add::make(base, slot));
+
+  Stmt initSlot = VarDecl::make(slot, ir::Rem::make(coord, width));
+  Stmt nextSlot = Assign::make(slot, ir::Rem::make(ir::Add::make(slot, 1),
+                                                   width));
+  Stmt probe = While::make(ir::And::make(Neq::make(slotCoord, -1),
+                                         Neq::make(slotCoord, coord)),
+                           nextSlot);
+  return ModeFunction(Block::make(initSlot, probe),
+                      {ir::Add::make(base, slot), Eq::make(slotCoord, coord)});
+}
+
+Stmt HashedModeFormat::getInsertCoord(Expr p, const std::vector<Expr>& i,
+                                      Mode mode) const {
+  return Store::make(getCoordArray(mode.getModePack()), p, i.back());
+}
+
+Expr HashedModeFormat::getWidth(Mode mode) const {
+  return (tableSize > 0) ? ir::Literal::make(tableSize)
+                         : getSizeArray(mode.getModePack());
+}
+
+Stmt HashedModeFormat::getInsertInitCoords(Expr pBegin, Expr pEnd,
+                                           Mode mode) const {
+  return clearSlots(pBegin, pEnd, mode);
+}
+
+Stmt HashedModeFormat::getInsertInitLevel(Expr szPrev, Expr sz,
+                                          Mode mode) const {
+  Expr crdArray = getCoordArray(mode.getModePack());
+  return Block::make(Allocate::make(crdArray, sz),
+                     clearSlots(0, sz, mode));
+}
+
+Stmt HashedModeFormat::getInsertFinalizeLevel(Expr szPrev, Expr sz,
+                                              Mode mode) const {
+  return Stmt();
+}
+
+Expr HashedModeFormat::getAssembledSize(Expr prevSize, Mode mode) const {
+  return ir::Mul::make(prevSize, getWidth(mode));
+}
+
+Stmt HashedModeFormat::getInitCoords(Expr prevSize,
+                                     std::vector<AttrQueryResult> queries,
+                                     Mode mode) const {
+  return getInsertInitLevel(prevSize, getAssembledSize(prevSize, mode), mode);
+}
+
+ModeFunction HashedModeFormat::getYieldPos(Expr parentPos,
+                                           std::vector<Expr> coords,
+                                           Mode mode) const {
+  return locate(parentPos, coords, mode);
+}
+
+Stmt HashedModeFormat::getInsertCoord(Expr parentPos, Expr pos,
+                                      std::vector<Expr> coords,
+                                      Mode mode) const {
+  return getInsertCoord(pos, coords, mode);
+}
+
+vector<Expr> HashedModeFormat::getArrays(Expr tensor, int mode,
+                                         int level) const {
+  std::string arraysName = util::toString(tensor) + std::to_string(level);
+  return {GetProperty::make(tensor, TensorProperty::Dimension, mode),
+          GetProperty::make(tensor, TensorProperty::Indices,
+                            level - 1, 1, arraysName + "_crd")};
+}
+
+int HashedModeFormat::getTableSize(int dimension) const {
+  return (tableSize > 0) ? tableSize : dimension;
+}
+
+Expr HashedModeFormat::getSizeArray(ModePack pack) const {
+  return pack.getArray(0);
+}
+
+Expr HashedModeFormat::getCoordArray(ModePack pack) const {
+  return pack.getArray(1);
+}
+
+Stmt HashedModeFormat::clearSlots(Expr begin, Expr end, Mode mode) const {
+  Expr crdArray = getCoordArray(mode.getModePack());
+  Expr pVar = Var::make("p" + mode.getName(), mode.getIndexType());
+  return For::make(pVar, begin, end, 1, Store::make(crdArray, pVar, -1));
+}
+
+bool HashedModeFormat::equals(const ModeFormatImpl& other) const {
+  return ModeFormatImpl::equals(other) &&
+         (dynamic_cast<const HashedModeFormat&>(other).tableSize == tableSize);
+}
+
+}
@@ -232,6 +232,11 @@ Stmt ModeFormatImpl::getAppendCoord(Expr p, Expr i,
   return Stmt();
 }
 
+Stmt ModeFormatImpl::getAppendCoord(Expr pPrev, Expr p, Expr i,
+    Mode mode) const {
+  return getAppendCoord(p, i, mode);
+}
+
 Stmt ModeFormatImpl::getAppendEdges(Expr pPrev, Expr pBegin,
     Expr pEnd, Mode mode) const {
   return Stmt();
@@ -293,6 +298,19 @@ Stmt ModeFormatImpl::getFinalizeYieldPos(Expr prevSize, Mode mode) const {
   return Stmt();
 }
 
+int ModeFormatImpl::getFixedSize() const {
+  return 0;
+}
+
+int ModeFormatImpl::getTableSize(int dimension) const {
+  return 0;
+}
+
+Expr ModeFormatImpl::getBitsetWord(Expr parentPos, Expr word,
+                                   Mode mode) const {
+  return Expr();
+}
+
 bool ModeFormatImpl::equals(const ModeFormatImpl& other) const {
   return (isFull == other.isFull &&
           isOrdered == other.isOrdered &&
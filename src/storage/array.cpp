@@ -18,6 +18,7 @@ struct Array::Content : util::Uncopyable {
   void*  data;
   size_t size;
   Policy policy = Array::UserOwns;
+  std::shared_ptr<void> owner;
 
   ~Content() {
     switch (policy) {
@@ -98,6 +99,11 @@ Array::Array(Datatype type, void* data, size_t size, Policy policy) : Array() {
   content->policy = policy;
 }
 
+Array::Array(Datatype type, void* data, size_t size, std::shared_ptr<void> owner)
+    : Array(type, data, size, UserOwns) {
+  content->owner = owner;
+}
+
 const Datatype& Array::getType() const {
   return content->type;
 }
@@ -0,0 +1,311 @@
+#include "taco/storage/file_io_bin.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "taco/tensor.h"
+#include "taco/format.h"
+#include "taco/error.h"
+#include "taco/storage/storage.h"
+#include "taco/storage/index.h"
+#include "taco/storage/array.h"
+#include "taco/util/files.h"
+
+using namespace std;
+
+namespace taco {
+
+// The file starts with a header of 64-bit words:
+//   magic, version, component type, order,
+//   dimensions[order], mode ordering[order],
+//   length of the format description, format description (padded to 8 bytes),
+//   number of index arrays of each mode[order],
+//   (type, size, offset) of each index array and of the values.
+// The arrays follow the header, each at an offset aligned to 64 bytes from the
+// start of the file, in the byte order of the machine that wrote them.
+static const char     binMagic[8] = {'T','A','C','O','B','I','N','\0'};
+static const uint64_t binVersion  = 1;
+static const uint64_t binAlignment = 64;
+
+static uint64_t align(uint64_t offset) {
+  return (offset + binAlignment - 1) / binAlignment * binAlignment;
+}
+
+/// Describes the mode formats and properties of a format, so that a reader
+/// can check that the arrays in a file have the layout it expects.
+static string describeFormat(const Format& format) {
+  stringstream description;
+  for (auto& pack : format.getModeFormatPacks()) {
+    description << "{";
+    for (auto& modeFormat : pack.getModeFormats()) {
+      description << modeFormat.getName() << ":"
+                  << modeFormat.isFull() << modeFormat.isOrdered()
+                  << modeFormat.isUnique() << modeFormat.isBranchless()
+                  << modeFormat.isCompact() << modeFormat.isZeroless()
+                  << modeFormat.isPadded() << ";";
+    }
+    description << "}";
+  }
+  return description.str();
+}
+
+/// Memory that backs the arrays of a tensor that was read from a binary file:
+/// either a mapping of the file or a buffer the stream was read into.
+struct BinaryContents {
+  char*  data   = nullptr;
+  size_t size   = 0;
+  bool   mapped = false;
+
+  ~BinaryContents() {
+    if (mapped) {
+      munmap(data, size);
+    }
+    else {
+      free(data);
+    }
+  }
+};
+
+/// Reads 64-bit words from the header of a binary file.
+class HeaderReader {
+public:
+  HeaderReader(const BinaryContents& contents) : contents(contents) {}
+
+  uint64_t word() {
+    uint64_t value;
+    bytes(&value, sizeof(value));
+    return value;
+  }
+
+  void bytes(void* destination, size_t size) {
+    taco_uassert(offset + size <= contents.size)
+        << "Binary tensor file is truncated";
+    memcpy(destination, contents.data + offset, size);
+    offset += size;
+  }
+
+  void skipTo(uint64_t position) {
+    offset = position;
+  }
+
+  uint64_t getOffset() const {
+    return offset;
+  }
+
+private:
+  const BinaryContents& contents;
+  uint64_t offset = 0;
+};
+
+static Datatype readType(HeaderReader& header) {
+  uint64_t kind = header.word();
+  taco_uassert(kind < Datatype::Undefined)
+      << "Binary tensor file has an invalid component type";
+  return Datatype((Datatype::Kind)kind);
+}
+
+template <typename T>
+static TensorBase dispatchReadBinary(shared_ptr<BinaryContents> contents,
+                                     const T& format) {
+  HeaderReader header(*contents);
+
+  char magic[sizeof(binMagic)];
+  header.bytes(magic, sizeof(magic));
+  taco_uassert(memcmp(magic, binMagic, sizeof(binMagic)) == 0)
+      << "Not a binary tensor file";
+  uint64_t version = header.word();
+  taco_uassert(version == binVersion)
+      << "Unsupported binary tensor file version " << version;
+
+  Datatype componentType = readType(header);
+  size_t order = header.word();
+
+  vector<int> dimensions(order);
+  for (auto& dimension : dimensions) {
+    dimension = (int)header.word();
+  }
+  vector<int> modeOrdering(order);
+  for (auto& mode : modeOrdering) {
+    mode = (int)header.word();
+  }
+
+  string description(header.word(), '\0');
+  header.bytes(&description[0], description.size());
+  header.skipTo((header.getOffset() + 7) / 8 * 8);
+
+  TensorBase tensor(componentType, dimensions, format);
+  taco_uassert(describeFormat(tensor.getFormat()) == description &&
+               tensor.getFormat().getModeOrdering() == modeOrdering)
+      << "The binary tensor file was not written in the format it is read in";
+
+  auto readArray = [&]() {
+    Datatype type = readType(header);
+    uint64_t size = header.word();
+    uint64_t offset = header.word();
+    taco_uassert(offset % binAlignment == 0 &&
+                 offset + size * type.getNumBytes() <= contents->size)
+        << "Binary tensor file is truncated";
+    return Array(type, contents->data + offset, size, contents);
+  };
+
+  vector<uint64_t> numIndexArrays(order);
+  for (auto& num : numIndexArrays) {
+    num = header.word();
+  }
+  vector<ModeIndex> modeIndices;
+  for (size_t i = 0; i < order; i++) {
+    vector<Array> indexArrays;
+    for (uint64_t j = 0; j < numIndexArrays[i]; j++) {
+      indexArrays.push_back(readArray());
+    }
+    modeIndices.push_back(ModeIndex(indexArrays));
+  }
+  Array values = readArray();
+  taco_uassert(values.getType() == componentType)
+      << "Binary tensor file has values of the wrong type";
+
+  TensorStorage storage = tensor.getStorage();
+  storage.setIndex(Index(tensor.getFormat(), modeIndices));
+  storage.setValues(values);
+  tensor.setStorage(storage);
+  return tensor;
+}
+
+static shared_ptr<BinaryContents> mapFile(const string& filename) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  taco_uassert(fd != -1) << "Error opening " << filename;
+  struct stat status;
+  int error = fstat(fd, &status);
+  taco_uassert(error == 0) << "Error reading " << filename;
+
+  auto contents = make_shared<BinaryContents>();
+  contents->size = status.st_size;
+  if (contents->size > 0) {
+    // Map the file copy-on-write so that the tensor's arrays can be modified
+    // without modifying the file.
+    void* data = mmap(nullptr, contents->size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE, fd, 0);
+    taco_uassert(data != MAP_FAILED) << "Error mapping " << filename;
+    contents->data = (char*)data;
+    contents->mapped = true;
+  }
+  close(fd);
+  return contents;
+}
+
+static shared_ptr<BinaryContents> readStream(istream& stream) {
+  auto contents = make_shared<BinaryContents>();
+  size_t capacity = 0;
+  do {
+    if (contents->size == capacity) {
+      capacity = std::max(capacity * 2, (size_t)1 << 16);
+      contents->data = (char*)realloc(contents->data, capacity);
+      taco_uassert(contents->data != nullptr)
+          << "Could not allocate memory for binary tensor";
+    }
+    stream.read(contents->data + contents->size, capacity - contents->size);
+    contents->size += stream.gcount();
+  } while (stream);
+  return contents;
+}
+
+TensorBase readBinary(std::string filename, const ModeFormat& modetype,
+                      bool pack) {
+  return dispatchReadBinary(mapFile(filename), modetype);
+}
+
+TensorBase readBinary(std::string filename, const Format& format, bool pack) {
+  return dispatchReadBinary(mapFile(filename), format);
+}
+
+TensorBase readBinary(std::istream& stream, const ModeFormat& modetype,
+                      bool pack) {
+  return dispatchReadBinary(readStream(stream), modetype);
+}
+
+TensorBase readBinary(std::istream& stream, const Format& format, bool pack) {
+  return dispatchReadBinary(readStream(stream), format);
+}
+
+void writeBinary(std::string filename, const TensorBase& tensor) {
+  writeBinary(filename, tensor.getStorage());
+}
+
+void writeBinary(std::ostream& stream, const TensorBase& tensor) {
+  writeBinary(stream, tensor.getStorage());
+}
+
+void writeBinary(std::string filename, const TensorStorage& storage) {
+  std::fstream file;
+  util::openStream(file, filename, fstream::out | fstream::binary);
+  writeBinary(file, storage);
+  file.close();
+}
+
+void writeBinary(std::ostream& stream, const TensorStorage& storage) {
+  const Format& format = storage.getFormat();
+  const Index& index = storage.getIndex();
+  size_t order = storage.getOrder();
+
+  vector<Array> arrays;
+  vector<uint64_t> header;
+  header.push_back(binVersion);
+  header.push_back(storage.getComponentType().getKind());
+  header.push_back(order);
+  for (int dimension : storage.getDimensions()) {
+    header.push_back(dimension);
+  }
+  for (int mode : format.getModeOrdering()) {
+    header.push_back(mode);
+  }
+  string description = describeFormat(format);
+  description.resize((description.size() + 7) / 8 * 8, '\0');
+  header.push_back(describeFormat(format).size());
+  vector<uint64_t> descriptionWords(description.size() / 8);
+  memcpy(descriptionWords.data(), description.data(), description.size());
+  header.insert(header.end(), descriptionWords.begin(), descriptionWords.end());
+  for (size_t i = 0; i < order; i++) {
+    const ModeIndex& modeIndex = index.getModeIndex(i);
+    header.push_back(modeIndex.numIndexArrays());
+    for (int j = 0; j < modeIndex.numIndexArrays(); j++) {
+      arrays.push_back(modeIndex.getIndexArray(j));
+    }
+  }
+  arrays.push_back(storage.getValues());
+
+  uint64_t offset = align(sizeof(binMagic) +
+                          (header.size() + 3 * arrays.size()) * sizeof(uint64_t));
+  vector<uint64_t> offsets;
+  for (auto& array : arrays) {
+    header.push_back(array.getType().getKind());
+    header.push_back(array.getSize());
+    header.push_back(offset);
+    offsets.push_back(offset);
+    offset = align(offset + array.getSize() * array.getType().getNumBytes());
+  }
+
+  stream.write(binMagic, sizeof(binMagic));
+  stream.write((const char*)header.data(), header.size() * sizeof(uint64_t));
+  uint64_t position = sizeof(binMagic) + header.size() * sizeof(uint64_t);
+  const char padding[binAlignment] = {};
+  for (size_t i = 0; i < arrays.size(); i++) {
+    stream.write(padding, offsets[i] - position);
+    size_t bytes = arrays[i].getSize() * arrays[i].getType().getNumBytes();
+    stream.write((const char*)arrays[i].getData(), bytes);
+    position = offsets[i] + bytes;
+  }
+  taco_uassert(bool(stream)) << "Error writing binary tensor";
+}
+
+}
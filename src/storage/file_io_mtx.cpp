@@ -12,37 +12,69 @@
 #include "taco/util/strings.h"
 #include "taco/util/timers.h"
 #include "taco/util/files.h"
+#include "file_io_text.h"
 
 using namespace std;
 
 namespace taco {
 
 template <typename T>
-TensorBase dispatchReadMTX(std::string filename, const T& format, bool pack) {
-  std::fstream file;
-  util::openStream(file, filename, fstream::in);
-  TensorBase tensor = readMTX(file, format, pack);
-  file.close();
-  return tensor;
-}
+static TensorBase readSparseText(const char* begin, const char* end,
+                                 const T& format, bool symm) {
+  // Skip comments at the top of the file
+  const char* line = skipComments(begin, end, '%');
+  const char* body = nextLine(line, end);
+
+  // The first non-comment line is the header with dimensions and the number
+  // of nonzeros, which may exceed INT_MAX
+  string headerLine(line, body);
+  vector<size_t> header;
+  char* linePtr = (char*)headerLine.c_str();
+  for (char* next = linePtr;; linePtr = next) {
+    size_t size = strtoul(linePtr, &next, 10);
+    if (next == linePtr) {
+      break;
+    }
+    header.push_back(size);
+  }
+  taco_uassert(!header.empty()) << "Matrix market header has no dimensions";
+  size_t nnz = header.back();
+  header.pop_back();
+  vector<int> dimensions;
+  for (size_t dimension : header) {
+    taco_uassert(dimension <= INT_MAX) << "Dimension exceeds INT_MAX";
+    dimensions.push_back(static_cast<int>(dimension));
+  }
+  if (symm)
+    taco_uassert(dimensions.size()==2) << "Symmetry only available for matrix";
 
-TensorBase readMTX(std::string filename, const ModeFormat& modetype, bool pack) {
-  return dispatchReadMTX(filename, modetype, pack);
-}
+  // Parse the entries in parallel
+  ParsedComponents components = parseComponents(body, end, dimensions.size(),
+                                                symm, '%');
+  taco_uassert(components.numLines == nnz)
+      << "MatrixMarket file has " << components.numLines << " entries but its "
+      << "header says it has " << nnz;
+  for (size_t mode = 0; mode < dimensions.size(); mode++) {
+    taco_uassert(components.maxCoordinates[mode] <= dimensions[mode])
+        << "MatrixMarket file has a coordinate larger than its dimension";
+  }
 
-TensorBase readMTX(std::string filename, const Format& format, bool pack) {
-  return dispatchReadMTX(filename, format, pack);
+  // Create matrix and insert the components
+  TensorBase tensor(type<double>(), dimensions, format);
+  insertComponents(tensor, components);
+  return tensor;
 }
 
 template <typename T>
-TensorBase dispatchReadMTX(std::istream& stream, const T& format, bool pack) {
-  string line;
-  if (!std::getline(stream, line)) {
+static TensorBase readMTXText(const TextFile& text, const T& format,
+                              bool pack) {
+  if (text.begin() == text.end()) {
     return TensorBase();
   }
+  const char* body = nextLine(text.begin(), text.end());
 
   // Read Header
-  std::stringstream lineStream(line);
+  std::stringstream lineStream(string(text.begin(), body));
   string head, type, formats, field, symmetry;
   lineStream >> head >> type >> formats >> field >> symmetry;
   taco_uassert(head=="%%MatrixMarket") << "Unknown header of MatrixMarket";
@@ -59,10 +91,13 @@ TensorBase dispatchReadMTX(std::istream& stream, const T& format, bool pack) {
   bool symm = (symmetry=="symmetric");
 
   TensorBase tensor;
-  if (formats=="coordinate")
-    tensor = readSparse(stream,format,symm);
-  else if (formats=="array")
-    tensor = readDense(stream,format,symm);
+  if (formats=="coordinate") {
+    tensor = readSparseText(body, text.end(), format, symm);
+  }
+  else if (formats=="array") {
+    std::stringstream stream(string(body, text.end()));
+    tensor = readDense(stream, format, symm);
+  }
   else
     taco_uerror << "MatrixMarket format not available";
 
@@ -73,6 +108,26 @@ TensorBase dispatchReadMTX(std::istream& stream, const T& format, bool pack) {
   return tensor;
 }
 
+template <typename T>
+TensorBase dispatchReadMTX(std::string filename, const T& format, bool pack) {
+  TextFile text(filename);
+  return readMTXText(text, format, pack);
+}
+
+TensorBase readMTX(std::string filename, const ModeFormat& modetype, bool pack) {
+  return dispatchReadMTX(filename, modetype, pack);
+}
+
+TensorBase readMTX(std::string filename, const Format& format, bool pack) {
+  return dispatchReadMTX(filename, format, pack);
+}
+
+template <typename T>
+TensorBase dispatchReadMTX(std::istream& stream, const T& format, bool pack) {
+  TextFile text(stream);
+  return readMTXText(text, format, pack);
+}
+
 TensorBase readMTX(std::istream& stream, const ModeFormat& modetype, bool pack) {
   return dispatchReadMTX(stream, modetype, pack);
 }
@@ -84,69 +139,8 @@ TensorBase readMTX(std::istream& stream, const Format& format, bool pack) {
 template <typename T>
 TensorBase dispatchReadSparse(std::istream& stream, const T& format, 
                               bool symm) {
-  string line;
-  std::getline(stream,line);
-
-  // Skip comments at the top of the file
-  string token;
-  do {
-    std::stringstream lineStream(line);
-    lineStream >> token;
-    if (token[0] != '%') {
-      break;
-    }
-  } while (std::getline(stream, line));
-
-  // The first non-comment line is the header with dimensions
-  vector<int> dimensions;
-  char* linePtr = (char*)line.data();
-  while (size_t dimension = strtoul(linePtr, &linePtr, 10)) {
-    taco_uassert(dimension <= INT_MAX) << "Dimension exceeds INT_MAX";
-    dimensions.push_back(static_cast<int>(dimension));
-  }
-  size_t nnz = dimensions[dimensions.size()-1];
-  dimensions.pop_back();
-  if (symm)
-    taco_uassert(dimensions.size()==2) << "Symmetry only available for matrix";
-
-  vector<int> coordinates;
-  vector<double> values;
-  coordinates.reserve(nnz*dimensions.size());
-  values.reserve(nnz);
-
-  while (std::getline(stream, line)) {
-    linePtr = (char*)line.data();
-    for (size_t i=0; i < dimensions.size(); i++) {
-      long index = strtol(linePtr, &linePtr, 10);
-      taco_uassert(index <= INT_MAX) << "Index exceeds INT_MAX";
-      coordinates.push_back(static_cast<int>(index));
-    }
-    double val = strtod(linePtr, &linePtr);
-    values.push_back(val);
-  }
-
-  // Create matrix
-  TensorBase tensor(type<double>(), dimensions, format);
-  if (symm)
-    tensor.reserve(2*nnz);
-  else
-    tensor.reserve(nnz);
-
-  // Insert coordinates
-  std::vector<int> coord;
-  for (size_t i = 0; i < nnz; i++) {
-    coord.clear();
-    for (size_t mode = 0; mode < dimensions.size(); mode++) {
-      coord.push_back(coordinates[i*dimensions.size() + mode] -1);
-    }
-    tensor.insert(coord, values[i]);
-    if (symm && coord.front() != coord.back()) {
-      std::reverse(coord.begin(), coord.end());
-      tensor.insert(coord, values[i]);
-    }
-  }
-
-  return tensor;
+  TextFile text(stream);
+  return readSparseText(text.begin(), text.end(), format, symm);
 }
 
 TensorBase readSparse(std::istream& stream, const ModeFormat& modetype, 
@@ -253,41 +247,18 @@ static void writeSparseTyped(std::ostream& stream, const TensorBase& tensor) {
   stream << "%"                                             << std::endl;
   stream << util::join(tensor.getDimensions(), " ") << " ";
   stream << tensor.getStorage().getIndex().getSize() << endl;
-  for (auto& value : iterate<T>(tensor)) {
-    for (int k = 0; k < tensor.getOrder(); ++k) {
-      stream << value.first[k]+1 << " ";
-    }
-    stream << value.second << endl;
-  }
+  writeComponents<T>(stream, tensor, true);
 }
 
-template<typename T>
-static void writeSparseCharTyped(std::ostream& stream, const TensorBase& tensor) {
-  if(tensor.getOrder() == 2)
-    stream << "%%MatrixMarket matrix coordinate real general" << std::endl;
-  else
-    stream << "%%MatrixMarket tensor coordinate real general" << std::endl;
-  stream << "%"                                             << std::endl;
-  stream << util::join(tensor.getDimensions(), " ") << " ";
-  stream << tensor.getStorage().getIndex().getSize() << endl;
-  for (auto& value : iterate<T>(tensor)) {
-    for (int k = 0; k < tensor.getOrder(); ++k) {
-      stream << value.first[k]+1 << " ";
-    }
-    stream << static_cast<int>(value.second) << endl;
-  }
-}
-
-
 void writeSparse(std::ostream& stream, const TensorBase& tensor) {
   switch(tensor.getComponentType().getKind()) {
     case Datatype::Bool: writeSparseTyped<bool>(stream, tensor); break;
-    case Datatype::UInt8: writeSparseCharTyped<uint8_t>(stream, tensor); break;
+    case Datatype::UInt8: writeSparseTyped<uint8_t>(stream, tensor); break;
     case Datatype::UInt16: writeSparseTyped<uint16_t>(stream, tensor); break;
     case Datatype::UInt32: writeSparseTyped<uint32_t>(stream, tensor); break;
     case Datatype::UInt64: writeSparseTyped<uint64_t>(stream, tensor); break;
     case Datatype::UInt128: writeSparseTyped<unsigned long long>(stream, tensor); break;
-    case Datatype::Int8: writeSparseCharTyped<int8_t>(stream, tensor); break;
+    case Datatype::Int8: writeSparseTyped<int8_t>(stream, tensor); break;
     case Datatype::Int16: writeSparseTyped<int16_t>(stream, tensor); break;
     case Datatype::Int32: writeSparseTyped<int32_t>(stream, tensor); break;
     case Datatype::Int64: writeSparseTyped<int64_t>(stream, tensor); break;
@@ -310,34 +281,18 @@ void writeDenseTyped(std::ostream& stream, const TensorBase& tensor) {
     stream << "%%MatrixMarket tensor array real general" << std::endl;
   stream << "%"                                        << std::endl;
   stream << util::join(tensor.getDimensions(), " ") << " " << endl;
-  for (auto& value : iterate<T>(tensor)) {
-    stream << value.second << endl;
-  }
-}
-
-template<typename T>
-void writeDenseCharTyped(std::ostream& stream, const TensorBase& tensor) {
-  if(tensor.getOrder() == 2)
-    stream << "%%MatrixMarket matrix array real general" << std::endl;
-  else
-    stream << "%%MatrixMarket tensor array real general" << std::endl;
-  stream << "%"                                        << std::endl;
-  stream << util::join(tensor.getDimensions(), " ") << " " << endl;
-  for (auto& value : iterate<T>(tensor)) {
-    stream << static_cast<int>(value.second) << endl;
-  }
+  writeComponents<T>(stream, tensor, false);
 }
 
-
 void writeDense(std::ostream& stream, const TensorBase& tensor) {
   switch(tensor.getComponentType().getKind()) {
     case Datatype::Bool: writeDenseTyped<bool>(stream, tensor); break;
-    case Datatype::UInt8: writeDenseCharTyped<uint8_t>(stream, tensor); break;
+    case Datatype::UInt8: writeDenseTyped<uint8_t>(stream, tensor); break;
     case Datatype::UInt16: writeDenseTyped<uint16_t>(stream, tensor); break;
     case Datatype::UInt32: writeDenseTyped<uint32_t>(stream, tensor); break;
     case Datatype::UInt64: writeDenseTyped<uint64_t>(stream, tensor); break;
     case Datatype::UInt128: writeDenseTyped<unsigned long long>(stream, tensor); break;
-    case Datatype::Int8: writeDenseCharTyped<int8_t>(stream, tensor); break;
+    case Datatype::Int8: writeDenseTyped<int8_t>(stream, tensor); break;
     case Datatype::Int16: writeDenseTyped<int16_t>(stream, tensor); break;
     case Datatype::Int32: writeDenseTyped<int32_t>(stream, tensor); break;
     case Datatype::Int64: writeDenseTyped<int64_t>(stream, tensor); break;
@@ -0,0 +1,320 @@
+#include "file_io_text.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "taco/tensor.h"
+#include "taco/error.h"
+#include "taco/util/parallel.h"
+
+using namespace std;
+
+namespace taco {
+
+TextFile::TextFile(const std::string& filename) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  taco_uassert(fd != -1) << "Error opening " << filename;
+  struct stat status;
+  int error = fstat(fd, &status);
+  taco_uassert(error == 0) << "Error reading " << filename;
+
+  size = status.st_size;
+  if (size > 0) {
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    taco_uassert(mapping != MAP_FAILED) << "Error mapping " << filename;
+    madvise(mapping, size, MADV_SEQUENTIAL);
+    data = (char*)mapping;
+    mapped = true;
+  }
+  close(fd);
+}
+
+TextFile::TextFile(std::istream& stream) {
+  string text((istreambuf_iterator<char>(stream)), istreambuf_iterator<char>());
+  size = text.size();
+  data = (char*)malloc(std::max<size_t>(size, 1));
+  taco_uassert(data != nullptr) << "Could not allocate memory for tensor file";
+  memcpy(data, text.data(), size);
+}
+
+TextFile::~TextFile() {
+  if (mapped) {
+    munmap(data, size);
+  }
+  else {
+    free(data);
+  }
+}
+
+const char* TextFile::begin() const {
+  return data;
+}
+
+const char* TextFile::end() const {
+  return data + size;
+}
+
+const char* nextLine(const char* line, const char* end) {
+  const char* newline = (const char*)memchr(line, '\n', end - line);
+  return (newline == nullptr) ? end : newline + 1;
+}
+
+static bool isBlank(char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+const char* skipComments(const char* line, const char* end, char comment) {
+  for (; line < end; line = nextLine(line, end)) {
+    const char* c = line;
+    while (c < end && isBlank(*c)) {
+      c++;
+    }
+    if (c < end && *c != '\n' && *c != comment) {
+      break;
+    }
+  }
+  return line;
+}
+
+static bool isDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+/// Parses a decimal integer at `p`, after any blanks, and advances `p` past
+/// it.  Returns false if there is no integer at `p`.
+static bool parseInteger(const char*& p, const char* end, long long& value) {
+  while (p < end && isBlank(*p)) {
+    p++;
+  }
+  bool negative = (p < end && *p == '-');
+  if (p < end && (*p == '-' || *p == '+')) {
+    p++;
+  }
+  if (p == end || !isDigit(*p)) {
+    return false;
+  }
+  unsigned long long magnitude = 0;
+  for (; p < end && isDigit(*p); p++) {
+    if (magnitude > (unsigned long long)LLONG_MAX / 10) {
+      return false;
+    }
+    magnitude = magnitude * 10 + (*p - '0');
+  }
+  value = negative ? -(long long)magnitude : (long long)magnitude;
+  return true;
+}
+
+/// Parses a floating-point number at `p`, after any blanks, and advances `p`
+/// past it.  Numbers whose decimal significand and power of ten are both
+/// exactly representable as doubles (most numbers written by programs) are
+/// converted directly, with the same result strtod gives; anything else is
+/// handed to strtod.  Returns false if there is no number at `p`.
+static bool parseDouble(const char*& p, const char* end, double& value) {
+  static const double powersOfTen[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+  const uint64_t maxExactSignificand = uint64_t(1) << 53;
+
+  while (p < end && isBlank(*p)) {
+    p++;
+  }
+  const char* start = p;
+  bool negative = (p < end && *p == '-');
+  if (p < end && (*p == '-' || *p == '+')) {
+    p++;
+  }
+
+  uint64_t significand = 0;
+  int numDigits = 0;
+  int exponent = 0;
+  bool exact = true;
+  for (; p < end && isDigit(*p); p++, numDigits++) {
+    if (significand < maxExactSignificand) {
+      significand = significand * 10 + (*p - '0');
+    }
+    else {
+      exact = false;
+    }
+  }
+  if (p < end && *p == '.') {
+    p++;
+    for (; p < end && isDigit(*p); p++, numDigits++) {
+      if (significand < maxExactSignificand) {
+        significand = significand * 10 + (*p - '0');
+        exponent--;
+      }
+      else {
+        exact = false;
+      }
+    }
+  }
+  if (numDigits == 0) {
+    // Not a plain decimal number (e.g. inf or nan)
+    exact = false;
+  }
+  else if (p < end && (*p == 'e' || *p == 'E')) {
+    const char* exponentStart = p++;
+    long long explicitExponent;
+    if (parseInteger(p, end, explicitExponent) && !isBlank(exponentStart[1]) &&
+        explicitExponent > -1000 && explicitExponent < 1000) {
+      exponent += (int)explicitExponent;
+    }
+    else {
+      exact = false;
+    }
+  }
+
+  if (exact && significand <= maxExactSignificand &&
+      exponent >= -22 && exponent <= 22) {
+    value = (exponent < 0) ? (double)significand / powersOfTen[-exponent]
+                           : (double)significand * powersOfTen[exponent];
+    value = negative ? -value : value;
+    return true;
+  }
+
+  // strtod needs a null-terminated string
+  p = start;
+  const char* tokenEnd = start;
+  while (tokenEnd < end && !isBlank(*tokenEnd) && *tokenEnd != '\n') {
+    tokenEnd++;
+  }
+  string token(start, tokenEnd);
+  char* parsedEnd;
+  value = strtod(token.c_str(), &parsedEnd);
+  p = start + (parsedEnd - token.c_str());
+  return parsedEnd != token.c_str();
+}
+
+ParsedComponents parseComponents(const char* begin, const char* end,
+                                 int order, bool symmetric, char comment) {
+  taco_iassert(!symmetric || order == 2);
+  const size_t componentSize = order * sizeof(int) + sizeof(double);
+
+  // Split the text into chunks that start at the beginning of a line
+  const size_t minChunkSize = 1 << 20;
+  const size_t size = end - begin;
+  const size_t numChunks = std::max<size_t>(1,
+      std::min<size_t>(4 * util::getNumHostThreads(), size / minChunkSize));
+  vector<const char*> chunkBegins = {begin};
+  for (size_t chunk = 1; chunk < numChunks; chunk++) {
+    const char* split = std::max(begin + size / numChunks * chunk,
+                                 chunkBegins.back());
+    chunkBegins.push_back((split == begin) ? begin
+                                           : nextLine(split - 1, end));
+  }
+  chunkBegins.push_back(end);
+
+  ParsedComponents components;
+  components.chunks.resize(numChunks);
+  vector<vector<int>> chunkMaxCoordinates(numChunks, vector<int>(order, 0));
+  vector<size_t> chunkNumLines(numChunks, 0);
+  util::parallelFor(numChunks, [&](size_t chunk) {
+    vector<char>& buffer = components.chunks[chunk];
+    vector<int>& maxCoordinates = chunkMaxCoordinates[chunk];
+    // Lines are usually longer than the components they hold
+    buffer.reserve((chunkBegins[chunk+1] - chunkBegins[chunk]) /
+                   (2 * order + 2) * componentSize);
+    vector<int> coordinate(order);
+    for (const char* line = chunkBegins[chunk]; line < chunkBegins[chunk+1];) {
+      const char* lineEnd = nextLine(line, end);
+      const char* p = line;
+      while (p < lineEnd && (isBlank(*p) || *p == '\n')) {
+        p++;
+      }
+      if (p == lineEnd || *p == comment) {
+        line = lineEnd;
+        continue;
+      }
+
+      for (int i = 0; i < order; i++) {
+        long long index;
+        taco_uassert(parseInteger(p, lineEnd, index))
+            << "Malformed line in tensor file: "
+            << string(line, lineEnd - line);
+        taco_uassert(index >= 1 && index <= INT_MAX)
+            << "Coordinate " << index << " in tensor file is out of range";
+        coordinate[i] = (int)index - 1;
+        maxCoordinates[i] = std::max(maxCoordinates[i], (int)index);
+      }
+      double value;
+      taco_uassert(parseDouble(p, lineEnd, value))
+          << "Malformed line in tensor file: " << string(line, lineEnd - line);
+
+      auto append = [&]() {
+        size_t offset = buffer.size();
+        buffer.resize(offset + componentSize);
+        memcpy(&buffer[offset], coordinate.data(), order * sizeof(int));
+        memcpy(&buffer[offset + order * sizeof(int)], &value, sizeof(double));
+      };
+      append();
+      chunkNumLines[chunk]++;
+      if (symmetric && coordinate[0] != coordinate[1]) {
+        std::swap(coordinate[0], coordinate[1]);
+        append();
+      }
+      line = lineEnd;
+    }
+  });
+
+  components.maxCoordinates.resize(order, 0);
+  for (size_t chunk = 0; chunk < numChunks; chunk++) {
+    components.numComponents += components.chunks[chunk].size() / componentSize;
+    components.numLines += chunkNumLines[chunk];
+    for (int i = 0; i < order; i++) {
+      components.maxCoordinates[i] = std::max(components.maxCoordinates[i],
+                                              chunkMaxCoordinates[chunk][i]);
+    }
+  }
+  return components;
+}
+
+void appendValue(std::string& text, double value) {
+  // The default formatting of std::ostream
+  char buffer[32];
+  int length = snprintf(buffer, sizeof(buffer), "%g", value);
+  text.append(buffer, length);
+}
+
+void appendValue(std::string& text, float value) {
+  appendValue(text, (double)value);
+}
+
+void appendValue(std::string& text, std::complex<float> value) {
+  appendValue(text, std::complex<double>(value));
+}
+
+void appendValue(std::string& text, std::complex<double> value) {
+  text += '(';
+  appendValue(text, value.real());
+  text += ',';
+  appendValue(text, value.imag());
+  text += ')';
+}
+
+void insertComponents(TensorBase& tensor, const ParsedComponents& components) {
+  taco_iassert(tensor.getComponentType() == Float64);
+  char* destination = tensor.appendComponents(components.numComponents);
+  vector<size_t> offsets = {0};
+  for (auto& chunk : components.chunks) {
+    offsets.push_back(offsets.back() + chunk.size());
+  }
+  util::parallelFor(components.chunks.size(), [&](size_t chunk) {
+    if (!components.chunks[chunk].empty()) {
+      memcpy(destination + offsets[chunk], components.chunks[chunk].data(),
+             components.chunks[chunk].size());
+    }
+  });
+}
+
+}
@@ -0,0 +1,159 @@
+#ifndef TACO_STORAGE_FILE_IO_TEXT_H
+#define TACO_STORAGE_FILE_IO_TEXT_H
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "taco/tensor.h"
+#include "taco/util/parallel.h"
+
+namespace taco {
+
+/// The text of a tensor file, either mapped into memory or read from a
+/// stream.  The text is not null-terminated.
+class TextFile {
+public:
+  /// Maps the file into memory.
+  explicit TextFile(const std::string& filename);
+
+  /// Reads the rest of the stream into memory.
+  explicit TextFile(std::istream& stream);
+
+  ~TextFile();
+
+  TextFile(const TextFile&) = delete;
+  TextFile& operator=(const TextFile&) = delete;
+
+  const char* begin() const;
+  const char* end() const;
+
+private:
+  char*  data   = nullptr;
+  size_t size   = 0;
+  bool   mapped = false;
+};
+
+/// Returns a pointer to the start of the line after the one at `line`, or to
+/// `end` if there is none.
+const char* nextLine(const char* line, const char* end);
+
+/// Returns a pointer to the first line at or after `line` that is neither
+/// blank nor starts with `comment` (after any blanks), or to `end`.
+const char* skipComments(const char* line, const char* end, char comment);
+
+/// Components parsed from lines of text, as chunks of components with
+/// zero-based coordinates, laid out the way TensorBase::appendComponents
+/// expects them for a Float64 tensor.
+struct ParsedComponents {
+  std::vector<std::vector<char>> chunks;
+
+  /// The largest one-based coordinate of each mode.
+  std::vector<int> maxCoordinates;
+
+  size_t numComponents = 0;
+
+  /// The number of lines that held components.
+  size_t numLines = 0;
+};
+
+/// Parses the lines in [begin, end), each of which holds `order` one-based
+/// coordinates followed by a value, on multiple threads.  Blank lines and
+/// lines that start with `comment` are skipped.  If `symmetric`, the
+/// component mirrored across the diagonal of each off-diagonal component of
+/// a matrix is added too.
+ParsedComponents parseComponents(const char* begin, const char* end,
+                                 int order, bool symmetric, char comment);
+
+/// Inserts parsed components into a Float64 tensor of the same order.
+void insertComponents(TensorBase& tensor, const ParsedComponents& components);
+
+/// Appends the decimal representation of an integer to `text`.
+template <typename T>
+void appendInteger(std::string& text, T value) {
+  char digits[48];
+  char* end = digits + sizeof(digits);
+  char* p = end;
+  const T zero = 0;
+  bool negative = value < zero;
+  // Negate digit by digit, since -value may overflow
+  do {
+    int digit = (int)(value % 10);
+    *--p = '0' + (negative ? -digit : digit);
+    value /= 10;
+  } while (value != 0);
+  if (negative) {
+    *--p = '-';
+  }
+  text.append(p, end - p);
+}
+
+/// Appends a component value to `text` the way an std::ostream with default
+/// settings formats it.
+void appendValue(std::string& text, double value);
+void appendValue(std::string& text, float value);
+void appendValue(std::string& text, std::complex<float> value);
+void appendValue(std::string& text, std::complex<double> value);
+
+inline void appendValue(std::string& text, bool value) {
+  text += value ? '1' : '0';
+}
+
+template <typename T>
+void appendValue(std::string& text, T value) {
+  appendInteger(text, value);
+}
+
+/// Writes the components of a packed tensor, one per line, as their one-based
+/// coordinates (if `writeCoordinates`) followed by their value.  Components
+/// are read with `iterate<T>` into shards that are formatted in parallel, and
+/// each shard's text is written to the stream in order with a single write.
+template <typename T>
+void writeComponents(std::ostream& stream, const TensorBase& tensor,
+                     bool writeCoordinates) {
+  const size_t shardSize = 1 << 16;
+  const size_t numShards = util::getNumHostThreads();
+  const int order = writeCoordinates ? tensor.getOrder() : 0;
+
+  std::vector<int> coordinates(numShards * shardSize * order);
+  std::vector<T> values(numShards * shardSize);
+  std::vector<std::string> text(numShards);
+  size_t numComponents = 0;
+  auto flush = [&]() {
+    util::parallelFor(numShards, [&](size_t shard) {
+      std::string& shardText = text[shard];
+      shardText.clear();
+      size_t end = std::min(numComponents, (shard + 1) * shardSize);
+      for (size_t i = shard * shardSize; i < end; i++) {
+        for (int k = 0; k < order; k++) {
+          appendInteger(shardText, coordinates[i * order + k] + 1);
+          shardText += ' ';
+        }
+        appendValue(shardText, static_cast<T>(values[i]));
+        shardText += '\n';
+      }
+    });
+    for (auto& shardText : text) {
+      stream.write(shardText.data(), shardText.size());
+    }
+    numComponents = 0;
+  };
+
+  for (auto& component : iterate<T>(tensor)) {
+    for (int k = 0; k < order; k++) {
+      coordinates[numComponents * order + k] = component.first[k];
+    }
+    values[numComponents++] = component.second;
+    if (numComponents == values.size()) {
+      flush();
+    }
+  }
+  flush();
+}
+
+}
+#endif
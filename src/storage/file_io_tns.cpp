@@ -3,6 +3,7 @@
 #include <iostream>
 #include <fstream>
 #include <cstdlib>
+#include <cctype>
 #include <algorithm>
 #include <vector>
 #include <cmath>
@@ -13,20 +14,47 @@
 #include "taco/error.h"
 #include "taco/util/strings.h"
 #include "taco/util/files.h"
+#include "file_io_text.h"
 
 using namespace std;
 
 namespace taco {
 
+/// Reads a tns tensor from its text, parsing chunks of lines in parallel.
 template <typename T>
-TensorBase dispatchReadTNS(std::string filename, const T& format, bool pack) {
-  std::fstream file;
-  util::openStream(file, filename, fstream::in);
-  TensorBase tensor = readTNS(file, format, pack);
-  file.close();
+static TensorBase readTNSText(const TextFile& text, const T& format,
+                              bool pack) {
+  // Infer tensor order from the number of fields in the first line
+  const char* line = skipComments(text.begin(), text.end(), '#');
+  if (line == text.end()) {
+    return TensorBase();
+  }
+  int numFields = 0;
+  for (const char* c = line; c < text.end() && *c != '\n'; c++) {
+    numFields += !isspace(*c) && (c == line || isspace(c[-1]));
+  }
+  int order = numFields - 1;
+
+  ParsedComponents components = parseComponents(text.begin(), text.end(),
+                                                order, false, '#');
+
+  // Create tensor and insert the components
+  TensorBase tensor(type<double>(), components.maxCoordinates, format);
+  insertComponents(tensor, components);
+
+  if (pack) {
+    tensor.pack();
+  }
+
   return tensor;
 }
 
+template <typename T>
+TensorBase dispatchReadTNS(std::string filename, const T& format, bool pack) {
+  TextFile text(filename);
+  return readTNSText(text, format, pack);
+}
+
 TensorBase readTNS(std::string filename, const ModeFormat& modetype, bool pack) {
   return dispatchReadTNS(filename, modetype, pack);
 }
@@ -37,53 +65,8 @@ TensorBase readTNS(std::string filename, const Format& format, bool pack) {
 
 template <typename T>
 TensorBase dispatchReadTNS(std::istream& stream, const T& format, bool pack) {
-  std::vector<int>    coordinates;
-  std::vector<double> values;
-
-  std::string line;
-  if (!std::getline(stream, line)) {
-    return TensorBase();
-  }
-
-  // Infer tensor order from the first coordinate
-  vector<string> toks = util::split(line, " ");
-  size_t order = toks.size()-1;
-  std::vector<int> dimensions(order);
-  std::vector<int> coordinate(order);
-
-  // Load data
-  do {
-    char* linePtr = (char*)line.data();
-    for (size_t i = 0; i < order; i++) {
-      long idx = strtol(linePtr, &linePtr, 10);
-      taco_uassert(idx <= INT_MAX)<<"Coordinate in file is larger than INT_MAX";
-      coordinate[i] = (int)idx - 1;
-      dimensions[i] = std::max(dimensions[i], (int)idx);
-    }
-    coordinates.insert(coordinates.end(), coordinate.begin(), coordinate.end());
-    double val = strtod(linePtr, &linePtr);
-    values.push_back(val);
-
-  } while (std::getline(stream, line));
-
-  // Create tensor
-  const size_t nnz = values.size();
-  TensorBase tensor(type<double>(), dimensions, format);
-  tensor.reserve(nnz);
-
-  // Insert coordinates (TODO add and use bulk insertion)
-  for (size_t i = 0; i < nnz; i++) {
-    for (size_t j = 0; j < order; j++) {
-      coordinate[j] = coordinates[i*order + j];
-    }
-    tensor.insert(coordinate, values[i]);
-  }
-
-  if (pack) {
-    tensor.pack();
-  }
-
-  return tensor;
+  TextFile text(stream);
+  return readTNSText(text, format, pack);
 }
 
 TensorBase readTNS(std::istream& stream, const ModeFormat& modetype, bool pack) {
@@ -103,34 +86,18 @@ void writeTNS(std::string filename, const TensorBase& tensor) {
 
 template<typename T>
 static void writeTypedTNS(std::ostream& stream, const TensorBase& tensor) {
-  for (auto& value : iterate<T>(tensor)) {
-    for (int k = 0; k < tensor.getOrder(); ++k) {
-      stream << value.first[k]+1 << " ";
-    }
-    stream << value.second << endl;
-  }
-}
-
-template<typename T>
-static void writeCharTNS(std::ostream& stream, const TensorBase& tensor) {
-  for (auto& value : iterate<T>(tensor)) {
-    for (int k = 0; k < tensor.getOrder(); ++k) {
-      stream << value.first[k]+1 << " ";
-    }
-    stream << static_cast<int>(value.second) << endl;
-  }
+  writeComponents<T>(stream, tensor, true);
 }
 
-
 void writeTNS(std::ostream& stream, const TensorBase& tensor) {
   switch(tensor.getComponentType().getKind()) {
     case Datatype::Bool: writeTypedTNS<bool>(stream, tensor); break;
-    case Datatype::UInt8: writeCharTNS<uint8_t>(stream, tensor); break;
+    case Datatype::UInt8: writeTypedTNS<uint8_t>(stream, tensor); break;
     case Datatype::UInt16: writeTypedTNS<uint16_t>(stream, tensor); break;
     case Datatype::UInt32: writeTypedTNS<uint32_t>(stream, tensor); break;
     case Datatype::UInt64: writeTypedTNS<uint64_t>(stream, tensor); break;
     case Datatype::UInt128: writeTypedTNS<unsigned long long>(stream, tensor); break;
-    case Datatype::Int8: writeCharTNS<int8_t>(stream, tensor); break;
+    case Datatype::Int8: writeTypedTNS<int8_t>(stream, tensor); break;
     case Datatype::Int16: writeTypedTNS<int16_t>(stream, tensor); break;
     case Datatype::Int32: writeTypedTNS<int32_t>(stream, tensor); break;
     case Datatype::Int64: writeTypedTNS<int64_t>(stream, tensor); break;
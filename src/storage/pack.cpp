@@ -1,6 +1,9 @@
 #include "taco/storage/pack.h"
 
+#include <algorithm>
 #include <climits>
+#include <cstdint>
+#include <cstring>
 
 #include "taco/format.h"
 #include "taco/error.h"
@@ -10,6 +13,7 @@
 #include "taco/storage/index.h"
 #include "taco/storage/array.h"
 #include "taco/util/collections.h"
+#include "taco/util/parallel.h"
 
 using namespace std;
 
@@ -115,6 +119,201 @@ inline bool sameSize(const std::vector<TypedIndexVector>& coordinates) {
   return true;
 }
 
+/// Returns the number of bits needed to represent values in [0, max].
+static int getNumBits(uint64_t max) {
+  int bits = 0;
+  while (max > 0) {
+    bits++;
+    max >>= 1;
+  }
+  return bits;
+}
+
+/// Splits [0, n) into chunks large enough to be worth a thread each, and
+/// returns the number of chunks.
+static size_t getNumChunks(size_t n) {
+  const size_t minChunkSize = 1 << 16;
+  return std::max<size_t>(1, std::min<size_t>(util::getNumHostThreads(),
+                                              n / minChunkSize));
+}
+
+static size_t getChunkBegin(size_t chunk, size_t numChunks, size_t n) {
+  return n / numChunks * chunk + std::min(chunk, n % numChunks);
+}
+
+/// Sorts `keys` stably with a least significant digit radix sort over their
+/// low `numBits` bits, carrying `indices` along.  Each pass histograms the
+/// digits of each chunk in parallel, and then scatters each chunk in parallel
+/// to the offsets the histograms give it.
+static void radixSort(std::vector<uint64_t>& keys, std::vector<size_t>& indices,
+                      int numBits) {
+  const int digitBits = 8;
+  const size_t numBuckets = size_t(1) << digitBits;
+  const size_t n = keys.size();
+  const size_t numChunks = getNumChunks(n);
+
+  std::vector<uint64_t> keysOut(n);
+  std::vector<size_t> indicesOut(n);
+  std::vector<size_t> offsets(numChunks * numBuckets);
+  for (int shift = 0; shift < numBits; shift += digitBits) {
+    util::parallelFor(numChunks, [&](size_t chunk) {
+      size_t* histogram = &offsets[chunk * numBuckets];
+      std::fill(histogram, histogram + numBuckets, 0);
+      size_t end = getChunkBegin(chunk + 1, numChunks, n);
+      for (size_t i = getChunkBegin(chunk, numChunks, n); i < end; i++) {
+        histogram[(keys[i] >> shift) & (numBuckets - 1)]++;
+      }
+    });
+
+    // Skip digits that all keys share
+    bool sharedDigit = false;
+    for (size_t bucket = 0; bucket < numBuckets && !sharedDigit; bucket++) {
+      size_t count = 0;
+      for (size_t chunk = 0; chunk < numChunks; chunk++) {
+        count += offsets[chunk * numBuckets + bucket];
+      }
+      sharedDigit = (count == n);
+    }
+    if (sharedDigit) {
+      continue;
+    }
+
+    size_t offset = 0;
+    for (size_t bucket = 0; bucket < numBuckets; bucket++) {
+      for (size_t chunk = 0; chunk < numChunks; chunk++) {
+        size_t count = offsets[chunk * numBuckets + bucket];
+        offsets[chunk * numBuckets + bucket] = offset;
+        offset += count;
+      }
+    }
+
+    util::parallelFor(numChunks, [&](size_t chunk) {
+      size_t* offset = &offsets[chunk * numBuckets];
+      size_t end = getChunkBegin(chunk + 1, numChunks, n);
+      for (size_t i = getChunkBegin(chunk, numChunks, n); i < end; i++) {
+        size_t destination = offset[(keys[i] >> shift) & (numBuckets - 1)]++;
+        keysOut[destination] = keys[i];
+        indicesOut[destination] = indices[i];
+      }
+    });
+    keys.swap(keysOut);
+    indices.swap(indicesOut);
+  }
+}
+
+void sortCoordinates(const char* components, size_t numComponents,
+                     size_t componentSize, const std::vector<int>& modeOrdering,
+                     size_t valueSize,
+                     std::vector<std::vector<int>>& coordinates, char* values) {
+  const int order = modeOrdering.size();
+  const size_t n = numComponents;
+  const size_t numChunks = getNumChunks(n);
+  auto getCoordinates = [&](size_t i) {
+    return (const int*)&components[i * componentSize];
+  };
+
+  // Find the range of each mode's coordinates, and whether the components are
+  // already sorted (in which case they are just copied).
+  std::vector<std::vector<int>> chunkMin(numChunks, std::vector<int>(order, 0));
+  std::vector<std::vector<int>> chunkMax(numChunks, std::vector<int>(order, 0));
+  std::vector<char> chunkSorted(numChunks, true);
+  util::parallelFor(numChunks, [&](size_t chunk) {
+    size_t begin = getChunkBegin(chunk, numChunks, n);
+    size_t end = getChunkBegin(chunk + 1, numChunks, n);
+    for (size_t i = begin; i < end; i++) {
+      const int* coordinate = getCoordinates(i);
+      for (int j = 0; j < order; j++) {
+        int c = coordinate[modeOrdering[j]];
+        chunkMin[chunk][j] = std::min(chunkMin[chunk][j], c);
+        chunkMax[chunk][j] = std::max(chunkMax[chunk][j], c);
+      }
+      if (i > 0 && chunkSorted[chunk]) {
+        const int* previous = getCoordinates(i - 1);
+        for (int j = 0; j < order; j++) {
+          int a = previous[modeOrdering[j]];
+          int b = coordinate[modeOrdering[j]];
+          if (a != b) {
+            chunkSorted[chunk] = (a < b);
+            break;
+          }
+        }
+      }
+    }
+  });
+  bool sorted = std::all_of(chunkSorted.begin(), chunkSorted.end(),
+                            [](char s) { return s; });
+
+  std::vector<size_t> indices;
+  if (!sorted) {
+    int numBits = 0;
+    bool nonnegative = true;
+    std::vector<int> modeBits(order);
+    for (int j = 0; j < order; j++) {
+      int min = 0;
+      int max = 0;
+      for (size_t chunk = 0; chunk < numChunks; chunk++) {
+        min = std::min(min, chunkMin[chunk][j]);
+        max = std::max(max, chunkMax[chunk][j]);
+      }
+      nonnegative = nonnegative && (min >= 0);
+      modeBits[j] = getNumBits(max);
+      numBits += modeBits[j];
+    }
+
+    indices.resize(n);
+    if (nonnegative && numBits <= 64) {
+      // Linearize the coordinates into keys that concatenate the bits of each
+      // mode's coordinate, and radix sort them.
+      std::vector<uint64_t> keys(n);
+      util::parallelFor(numChunks, [&](size_t chunk) {
+        size_t end = getChunkBegin(chunk + 1, numChunks, n);
+        for (size_t i = getChunkBegin(chunk, numChunks, n); i < end; i++) {
+          const int* coordinate = getCoordinates(i);
+          uint64_t key = 0;
+          for (int j = 0; j < order; j++) {
+            key = (key << modeBits[j]) |
+                  (uint64_t)coordinate[modeOrdering[j]];
+          }
+          keys[i] = key;
+          indices[i] = i;
+        }
+      });
+      radixSort(keys, indices, numBits);
+    }
+    else {
+      // The keys do not fit in 64 bits, so compare the coordinates instead
+      for (size_t i = 0; i < n; i++) {
+        indices[i] = i;
+      }
+      std::stable_sort(indices.begin(), indices.end(), [&](size_t a, size_t b) {
+        const int* ca = getCoordinates(a);
+        const int* cb = getCoordinates(b);
+        for (int j = 0; j < order; j++) {
+          if (ca[modeOrdering[j]] != cb[modeOrdering[j]]) {
+            return ca[modeOrdering[j]] < cb[modeOrdering[j]];
+          }
+        }
+        return false;
+      });
+    }
+  }
+
+  // Write the sorted components out as one array per mode and a value array
+  for (int j = 0; j < order; j++) {
+    coordinates[j].resize(n);
+  }
+  util::parallelFor(numChunks, [&](size_t chunk) {
+    size_t end = getChunkBegin(chunk + 1, numChunks, n);
+    for (size_t i = getChunkBegin(chunk, numChunks, n); i < end; i++) {
+      const int* coordinate = getCoordinates(sorted ? i : indices[i]);
+      for (int j = 0; j < order; j++) {
+        coordinates[j][i] = coordinate[modeOrdering[j]];
+      }
+      memcpy(&values[i * valueSize], coordinate + order, valueSize);
+    }
+  });
+}
+
 /// Pack tensor coordinates into a format. The coordinates must be stored as a
 /// structure of arrays, that is one vector per axis coordinate and one vector
 /// for the values. The coordinates must be sorted lexicographically.
@@ -0,0 +1,159 @@
+#include "taco/storage/sell.h"
+
+#include <algorithm>
+#include <complex>
+#include <numeric>
+#include <vector>
+
+#include "taco/tensor.h"
+#include "taco/format.h"
+#include "taco/error.h"
+#include "taco/storage/storage.h"
+#include "taco/storage/index.h"
+#include "taco/storage/array.h"
+#include "taco/util/parallel.h"
+
+using namespace std;
+
+namespace taco {
+
+template <typename T>
+static TensorBase packTypedSELL(const TensorBase& matrix, int sliceSize,
+                                int sortWindow, vector<int>* rowPermutation) {
+  const int numRows = matrix.getDimension(0);
+  const int numCols = matrix.getDimension(1);
+
+  // Gather the nonzeros of each row, ordered by column
+  vector<pair<int,int>> coordinates;
+  vector<T> values;
+  vector<size_t> rowPos(numRows + 1, 0);
+  for (auto& component : iterate<T>(matrix)) {
+    coordinates.push_back({component.first[0], component.first[1]});
+    values.push_back(component.second);
+    rowPos[component.first[0] + 1]++;
+  }
+  partial_sum(rowPos.begin(), rowPos.end(), rowPos.begin());
+  vector<size_t> order(coordinates.size());
+  vector<size_t> next(rowPos.begin(), rowPos.end() - 1);
+  for (size_t i = 0; i < coordinates.size(); i++) {
+    order[next[coordinates[i].first]++] = i;
+  }
+  util::parallelFor(numRows, [&](size_t row) {
+    sort(order.begin() + rowPos[row], order.begin() + rowPos[row + 1],
+         [&](size_t a, size_t b) {
+           return coordinates[a].second < coordinates[b].second;
+         });
+  });
+
+  // Sort the rows by decreasing length within each window
+  const int numSlices = (numRows + sliceSize - 1) / sliceSize;
+  vector<int> permutation(numSlices * sliceSize, -1);
+  iota(permutation.begin(), permutation.begin() + numRows, 0);
+  auto rowLength = [&](int row) {
+    return (row < 0) ? 0 : (int)(rowPos[row + 1] - rowPos[row]);
+  };
+  for (int window = 0; window < numRows; window += sortWindow) {
+    stable_sort(permutation.begin() + window,
+                permutation.begin() + std::min(window + sortWindow, numRows),
+                [&](int a, int b) { return rowLength(a) > rowLength(b); });
+  }
+
+  // Slices are as wide as their longest row
+  vector<size_t> slicePos(numSlices + 1, 0);
+  int maxWidth = 1;
+  for (int s = 0; s < numSlices; s++) {
+    int width = 0;
+    for (int c = 0; c < sliceSize; c++) {
+      width = std::max(width, rowLength(permutation[s * sliceSize + c]));
+    }
+    slicePos[s + 1] = slicePos[s] + (size_t)width * sliceSize;
+    maxWidth = std::max(maxWidth, width);
+  }
+
+  // Write the index arrays and values of each slice directly, as the pack
+  // code cannot assemble singleton modes below dense modes.  Short rows are
+  // padded with zeros that repeat the last column of the row (or column 0
+  // for empty rows), so padding never loads new cache lines of x.
+  const size_t size = slicePos[numSlices];
+  Array slotPos = makeArray(Int32, numSlices + 1);
+  Array slotCrd = makeArray(Int32, size / sliceSize);
+  Array colCrd = makeArray(Int32, size);
+  Array vals = makeArray(matrix.getComponentType(), size);
+  int* slotPosData = (int*)slotPos.getData();
+  int* slotCrdData = (int*)slotCrd.getData();
+  int* colCrdData = (int*)colCrd.getData();
+  T* valsData = (T*)vals.getData();
+  for (int s = 0; s <= numSlices; s++) {
+    slotPosData[s] = (int)(slicePos[s] / sliceSize);
+  }
+  util::parallelFor(numSlices, [&](size_t s) {
+    const int width = slotPosData[s + 1] - slotPosData[s];
+    for (int k = 0; k < width; k++) {
+      slotCrdData[slotPosData[s] + k] = k;
+    }
+    for (int c = 0; c < sliceSize; c++) {
+      const int row = permutation[s * sliceSize + c];
+      const size_t begin = (row < 0) ? 0 : rowPos[row];
+      const int length = rowLength(row);
+      for (int k = 0; k < width; k++) {
+        const size_t p = slicePos[s] + (size_t)k * sliceSize + c;
+        if (k < length) {
+          colCrdData[p] = coordinates[order[begin + k]].second;
+          valsData[p] = values[order[begin + k]];
+        } else {
+          colCrdData[p] = (length > 0) ? colCrdData[p - sliceSize] : 0;
+          valsData[p] = T();
+        }
+      }
+    }
+  });
+
+  const Format format = SELL(sliceSize);
+  TensorBase sell(matrix.getComponentType(),
+                  {numSlices, maxWidth, sliceSize, numCols}, format);
+  TensorStorage storage = sell.getStorage();
+  storage.setIndex(Index(format, {ModeIndex({makeArray({numSlices})}),
+                                  ModeIndex({slotPos, slotCrd}),
+                                  ModeIndex({makeArray({sliceSize})}),
+                                  ModeIndex({makeArray(Int32, 0), colCrd})}));
+  storage.setValues(vals);
+  sell.setStorage(storage);
+
+  if (rowPermutation != nullptr) {
+    *rowPermutation = permutation;
+  }
+  return sell;
+}
+
+TensorBase packSELL(const TensorBase& matrix, int sliceSize, int sortWindow,
+                    vector<int>* rowPermutation) {
+  taco_uassert(matrix.getOrder() == 2) << "SELL-C-sigma stores matrices";
+  taco_uassert(sliceSize > 0 && sortWindow > 0) <<
+      "Slice size and sort window must be positive";
+  switch (matrix.getComponentType().getKind()) {
+    case Datatype::Int32:
+      return packTypedSELL<int32_t>(matrix, sliceSize, sortWindow,
+                                    rowPermutation);
+    case Datatype::Int64:
+      return packTypedSELL<int64_t>(matrix, sliceSize, sortWindow,
+                                    rowPermutation);
+    case Datatype::Float32:
+      return packTypedSELL<float>(matrix, sliceSize, sortWindow,
+                                  rowPermutation);
+    case Datatype::Float64:
+      return packTypedSELL<double>(matrix, sliceSize, sortWindow,
+                                   rowPermutation);
+    case Datatype::Complex64:
+      return packTypedSELL<std::complex<float>>(matrix, sliceSize, sortWindow,
+                                                rowPermutation);
+    case Datatype::Complex128:
+      return packTypedSELL<std::complex<double>>(matrix, sliceSize,
+                                                 sortWindow, rowPermutation);
+    default:
+      taco_not_supported_yet;
+      break;
+  }
+  return TensorBase();
+}
+
+}
@@ -50,7 +50,9 @@ struct TensorStorage::Content {
         modeTypes[i] = taco_mode_dense;
       } else if (modeType.getName() == Sparse.getName()) {
         modeTypes[i] = taco_mode_sparse;
-      } else if (modeType.getName() == Singleton.getName()) {
+      } else if (modeType.getName() == Singleton.getName() ||
+                 modeType.getName() == Hashed().getName() ||
+                 modeType.getName() == Bitmap.getName()) {
         modeTypes[i] = taco_mode_sparse;
       } else {
         taco_not_supported_yet;
@@ -143,8 +145,9 @@ TensorStorage::operator struct taco_tensor_t*() const {
       const Array& size = modeIndex.getIndexArray(0);
       tensorData->indices[i][0] = (uint8_t*)size.getData();
     }
-    // Sparse levels have two indices (pos and idx)
-    else if (modeType.getName() == Sparse.getName()) {
+    // Sparse and bitmap levels have two indices (pos and idx or bits)
+    else if (modeType.getName() == Sparse.getName() ||
+             modeType.getName() == Bitmap.getName()) {
       // TODO Uncomment assert and remove conditional
       // taco_iassert(modeIndex.numIndexArrays() == 2)
       //     << modeIndex.numIndexArrays();
@@ -155,7 +158,8 @@ TensorStorage::operator struct taco_tensor_t*() const {
         tensorData->indices[i][1] = (uint8_t*)idx.getData();
       }
     }
-    else if (modeType.getName() == Singleton.getName()) {
+    else if (modeType.getName() == Singleton.getName() ||
+             modeType.getName() == Hashed().getName()) {
       // TODO Uncomment assert and remove conditional
       // taco_iassert(modeIndex.numIndexArrays() == 2)
       //     << modeIndex.numIndexArrays();
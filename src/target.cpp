@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "taco/target.h"
+#include "taco/util/env.h"
 
 using namespace std;
 
@@ -16,6 +17,11 @@ map<string, Target::OS> osMap = {{"unknown", Target::OSUnknown},
                                   {"linux", Target::Linux},
                                   {"macos", Target::MacOS},
                                   {"windows", Target::Windows}};
+
+map<string, Target::CompileTier> compileTierMap =
+    {{"optimized", Target::Optimized},
+     {"fast",      Target::Fast},
+     {"tiered",    Target::Tiered}};
   
 bool parseTargetString(Target& target, string target_string) {
   string rest = target_string;
@@ -76,6 +82,11 @@ bool Target::validateTargetString(const string &s) {
 }
 
 Target getTargetFromEnvironment() {
-  return Target(Target::Arch::C99, Target::OS::MacOS);
+  Target target(Target::Arch::C99, Target::OS::MacOS);
+  string tier = util::getFromEnv("TACO_COMPILE_TIER", "optimized");
+  taco_uassert(compileTierMap.count(tier))
+      << "Invalid TACO_COMPILE_TIER: " << tier;
+  target.compileTier = compileTierMap[tier];
+  return target;
 }
 } // namespace taco
@@ -9,6 +9,11 @@
 #include <vector>
 #include <utility>
 #include <mutex>
+#include <atomic>
+#include <thread>
+#include <limits>
+#include <algorithm>
+#include <chrono>
 
 #include "taco/cuda.h"
 #include "taco/format.h"
@@ -22,6 +27,7 @@
 //#include "taco/taco_tensor_t.h"
 #include "taco/index_notation/index_notation_visitor.h"
 #include "taco/index_notation/transformations.h"
+#include "taco/accelerator_notation/autotune.h"
 #include "taco/ir/ir.h"
 #include "taco/ir/ir_printer.h"
 #include "taco/lower/lower.h"
@@ -32,10 +38,12 @@
 #include "taco/storage/file_io_tns.h"
 #include "taco/storage/file_io_mtx.h"
 #include "taco/storage/file_io_rb.h"
+#include "taco/storage/file_io_bin.h"
 #include "taco/storage/typed_vector.h"
 #include "taco/util/collections.h"
 #include "taco/util/strings.h"
 #include "taco/util/timers.h"
+#include "taco/util/env.h"
 #include "taco/util/name_generator.h"
 
 #include "codegen/codegen_c.h"
@@ -87,6 +95,7 @@ TensorBase::TensorBase(std::string name, Datatype ctype, std::vector<int> dimens
 static Format initFormat(Format format) {
   // Initialize coordinate types for Format if not already set
   if (format.getLevelArrayTypes().size() < (size_t)format.getOrder()) {
+    const Datatype indexType = format.getIndexType();
     std::vector<std::vector<Datatype>> levelArrayTypes;
     for (int i = 0; i < format.getOrder(); ++i) {
       std::vector<Datatype> arrayTypes;
@@ -94,11 +103,17 @@ static Format initFormat(Format format) {
       if (modeType.getName() == Dense.getName()) {
         arrayTypes.push_back(Int32);
       } else if (modeType.getName() == Sparse.getName()) {
-        arrayTypes.push_back(Int32);
-        arrayTypes.push_back(Int32);
+        arrayTypes.push_back(indexType);
+        arrayTypes.push_back(indexType);
       } else if (modeType.getName() == Singleton.getName()) {
+        arrayTypes.push_back(indexType);
+        arrayTypes.push_back(indexType);
+      } else if (modeType.getName() == Hashed().getName()) {
         arrayTypes.push_back(Int32);
-        arrayTypes.push_back(Int32);
+        arrayTypes.push_back(indexType);
+      } else if (modeType.getName() == Bitmap.getName()) {
+        arrayTypes.push_back(indexType);
+        arrayTypes.push_back(UInt64);
       } else {
         taco_not_supported_yet;
       }
@@ -129,6 +144,12 @@ TensorBase::TensorBase(string name, Datatype ctype, vector<int> dimensions,
   // Initialize dense storage modes
   // TODO: Get rid of this and make code use dimensions instead of dense indices
   for (int i = 0; i < format.getOrder(); ++i) {
+    const int fixedSize = format.getModeFormats()[i].getFixedSize();
+    taco_uassert(fixedSize == 0 ||
+                 fixedSize == dimensions[format.getModeOrdering()[i]]) <<
+        "Mode " << format.getModeOrdering()[i] << " of size " <<
+        dimensions[format.getModeOrdering()[i]] << " must be of size " <<
+        fixedSize << " to be stored in blocks of that size.";
     if (format.getModeFormats()[i].getName() == Dense.getName()) {
       const size_t idx = format.getModeOrdering()[i];
       modeIndices[i] = ModeIndex({makeArray({content->dimensions[idx]})});
@@ -173,6 +194,20 @@ void TensorBase::reserve(size_t numCoordinates) {
   content->coordinateBuffer->resize(newSize);
 }
 
+char* TensorBase::appendComponents(size_t numComponents) {
+  syncDependentTensors();
+  size_t used = content->coordinateBufferUsed +
+                numComponents * content->coordinateSize;
+  if (content->coordinateBuffer->size() < used) {
+    content->coordinateBuffer->resize(used);
+  }
+  char* components =
+      &content->coordinateBuffer->data()[content->coordinateBufferUsed];
+  content->coordinateBufferUsed = used;
+  setNeedsPack(true);
+  return components;
+}
+
 void TensorBase::setProperty(std::string property){
   content->properties.insert(property);
 }
@@ -275,22 +310,18 @@ void TensorBase::setAssembleWhileCompute(bool assembleWhileCompute) {
   content->assembleWhileCompute = assembleWhileCompute;
 }
 
-static size_t numIntegersToCompare = 0;
-static int lexicographicalCmp(const void* a, const void* b) {
-  for (size_t i = 0; i < numIntegersToCompare; i++) {
-    int diff = ((int*)a)[i] - ((int*)b)[i];
-    if (diff != 0) {
-      return diff;
-    }
-  }
-  return 0;
-}
-
 static size_t unpackTensorData(const taco_tensor_t& tensorData,
                                const TensorBase& tensor) {
   auto storage = tensor.getStorage();
   auto format = storage.getFormat();
 
+  // Positions and coordinates are 64-bit in tensors with a 64-bit index type
+  const Datatype indexType = format.getIndexType();
+  auto getPosition = [&](const uint8_t* array, size_t i) -> size_t {
+    return (indexType == Int64) ? ((const int64_t*)array)[i]
+                                : ((const int32_t*)array)[i];
+  };
+
   vector<ModeIndex> modeIndices;
   size_t numVals = 1;
   for (int i = 0; i < tensor.getOrder(); i++) {
@@ -300,14 +331,27 @@ static size_t unpackTensorData(const taco_tensor_t& tensorData,
       modeIndices.push_back(ModeIndex({size}));
       numVals *= ((int*)tensorData.indices[i][0])[0];
     } else if (modeType.getName() == Sparse.getName()) {
-      auto size = ((int*)tensorData.indices[i][0])[numVals];
-      Array pos = Array(type<int>(), tensorData.indices[i][0], numVals+1, Array::Free);
-      Array idx = Array(type<int>(), tensorData.indices[i][1], size, Array::Free);
+      auto size = getPosition(tensorData.indices[i][0], numVals);
+      Array pos = Array(indexType, tensorData.indices[i][0], numVals+1, Array::Free);
+      Array idx = Array(indexType, tensorData.indices[i][1], size, Array::Free);
       modeIndices.push_back(ModeIndex({pos, idx}));
       numVals = size;
     } else if (modeType.getName() == Singleton.getName()) {
-      Array idx = Array(type<int>(), tensorData.indices[i][1], numVals, Array::Free);
-      modeIndices.push_back(ModeIndex({makeArray(type<int>(), 0), idx}));
+      Array idx = Array(indexType, tensorData.indices[i][1], numVals, Array::Free);
+      modeIndices.push_back(ModeIndex({makeArray(indexType, 0), idx}));
+    } else if (modeType.getName() == Hashed().getName()) {
+      const int dimension = tensor.getDimension(format.getModeOrdering()[i]);
+      numVals *= modeType.getTableSize(dimension);
+      Array idx = Array(indexType, tensorData.indices[i][1], numVals, Array::Free);
+      modeIndices.push_back(ModeIndex({makeArray(indexType, 0), idx}));
+    } else if (modeType.getName() == Bitmap.getName()) {
+      const int dimension = tensor.getDimension(format.getModeOrdering()[i]);
+      const size_t numWords = numVals * ((dimension + 63) / 64);
+      auto size = getPosition(tensorData.indices[i][0], numWords);
+      Array pos = Array(indexType, tensorData.indices[i][0], numWords+1, Array::Free);
+      Array bits = Array(UInt64, tensorData.indices[i][1], numWords, Array::Free);
+      modeIndices.push_back(ModeIndex({pos, bits}));
+      numVals = size;
     } else {
       taco_not_supported_yet;
     }
@@ -386,6 +430,9 @@ void TensorBase::pack() {
 
   taco_iassert((content->coordinateBufferUsed % content->coordinateSize) == 0);
   const size_t numCoordinates = content->coordinateBufferUsed / content->coordinateSize;
+  taco_uassert(numCoordinates <= INT_MAX || getFormat().getIndexType() == Int64)
+      << "Tensors with more than " << INT_MAX << " components must have a "
+      << "format with a 64-bit index type (see Format::setIndexType)";
 
   const auto helperFuncs = getHelperFunctions(getFormat(), getComponentType(),
                                               dimensions);
@@ -403,8 +450,11 @@ void TensorBase::pack() {
     taco_tensor_t* bufferStorage = init_taco_tensor_t(1, csize,
         (int32_t*)bufferDim.data(), (int32_t*)bufferModeOrdering.data(),
         (taco_mode_t*)bufferModeType.data(), fillPtr);
-    std::vector<int> pos = {0, (int)numCoordinates};
-    bufferStorage->indices[0][0] = (uint8_t*)pos.data();
+    std::vector<int64_t> pos = {0, (int64_t)numCoordinates};
+    std::vector<int> pos32 = {0, (int)numCoordinates};
+    bufferStorage->indices[0][0] = (getFormat().getIndexType() == Int64)
+                                   ? (uint8_t*)pos.data()
+                                   : (uint8_t*)pos32.data();
     bufferStorage->indices[0][1] = (uint8_t*)bufferCoords.data();
 
     bufferStorage->vals = (uint8_t*)content->coordinateBuffer->data();
@@ -418,51 +468,15 @@ void TensorBase::pack() {
     return;
   }
 
-  // Permute the coordinates according to the storage mode ordering.
-  // This is a workaround since the current pack code only packs tensors in the
-  // ordering of the modes.
+  // The pack code expects the coordinates to be sorted in the ordering of the
+  // modes, and as one array per mode.
   taco_iassert(getFormat().getOrder() == order);
   std::vector<int> permutation = getFormat().getModeOrdering();
-  std::vector<int> permutedDimensions(order);
-  for (int i = 0; i < order; ++i) {
-    permutedDimensions[i] = dimensions[permutation[i]];
-  }
-
-  const size_t coordSize = content->coordinateSize;
-  char* coordinatesPtr = content->coordinateBuffer->data();
-  vector<int> permuteBuffer(order);
-  for (size_t i = 0; i < numCoordinates; ++i) {
-    int* coordinate = (int*)coordinatesPtr;
-    for (int j = 0; j < order; j++) {
-      permuteBuffer[j] = coordinate[permutation[j]];
-    }
-    for (int j = 0; j < order; j++) {
-      coordinate[j] = permuteBuffer[j];
-    }
-    coordinatesPtr += content->coordinateSize;
-  }
-  coordinatesPtr = content->coordinateBuffer->data();
-
-  // The pack code expects the coordinates to be sorted
-  numIntegersToCompare = order;
-  qsort(coordinatesPtr, numCoordinates, coordSize, lexicographicalCmp);
-
-
-  // Move coords into separate arrays
   std::vector<std::vector<int>> coordinates(order);
-  for (int i = 0; i < order; ++i) {
-    coordinates[i] = std::vector<int>(numCoordinates);
-  }
   char* values = (char*) malloc(numCoordinates * csize);
-  for (size_t i = 0; i < numCoordinates; ++i) {
-    int* coordLoc = (int*)&coordinatesPtr[i * coordSize];
-    for (int d = 0; d < order; ++d) {
-      coordinates[d][i] = *coordLoc;
-      coordLoc++;
-    }
-    memcpy(&values[i * csize], coordLoc, csize);
-  }
-
+  sortCoordinates(content->coordinateBuffer->data(), numCoordinates,
+                  content->coordinateSize, permutation, csize, coordinates,
+                  values);
 
   content->coordinateBuffer->clear();
   content->coordinateBufferUsed = 0;
@@ -472,8 +486,11 @@ void TensorBase::pack() {
   taco_tensor_t* bufferStorage = init_taco_tensor_t(order, csize,
       (int32_t*)dimensions.data(), (int32_t*)permutation.data(),
       (taco_mode_t*)bufferModeTypes.data(), fillPtr);
-  std::vector<int> pos = {0, (int)numCoordinates};
-  bufferStorage->indices[0][0] = (uint8_t*)pos.data();
+  std::vector<int64_t> pos = {0, (int64_t)numCoordinates};
+  std::vector<int> pos32 = {0, (int)numCoordinates};
+  bufferStorage->indices[0][0] = (getFormat().getIndexType() == Int64)
+                                 ? (uint8_t*)pos.data()
+                                 : (uint8_t*)pos32.data();
   for (int i = 0; i < order; ++i) {
     bufferStorage->indices[i][1] = (uint8_t*)coordinates[i].data();
   }
@@ -614,21 +631,69 @@ const Access TensorBase::operator()() const {
   return this->operator()(std::vector<IndexVar>());
 }
 
+struct TensorBase::KernelsCacheEntry {
+  KernelsCacheEntry(IndexStmt stmt, bool assembleWhileCompute,
+                    std::shared_ptr<Module> kernel, uint64_t lastUse)
+      : stmt(stmt), assembleWhileCompute(assembleWhileCompute), kernel(kernel),
+        lastUse(lastUse) {}
+
+  IndexStmt stmt;
+  bool assembleWhileCompute;
+  std::shared_ptr<Module> kernel;
+
+  /// Updated by lookups, which only hold a shared lock on the cache.
+  std::atomic<uint64_t> lastUse;
+};
+
 TensorBase::KernelsCache TensorBase::computeKernels;
-std::mutex TensorBase::computeKernelsMutex;
-
-std::shared_ptr<Module> TensorBase::getComputeKernel(const IndexStmt stmt) {
-  computeKernelsMutex.lock();
-  const auto computeKernelsReverse =
-      util::ReverseConstIterable<TensorBase::KernelsCache>(computeKernels);
-  for (const auto& computeKernel : computeKernelsReverse) {
-    if (isomorphic(stmt, computeKernel.first)) {
-      const auto kernelModule = computeKernel.second;
-      computeKernelsMutex.unlock();
-      return kernelModule;
+size_t TensorBase::numComputeKernels = 0;
+std::shared_timed_mutex TensorBase::computeKernelsMutex;
+
+static std::atomic<uint64_t> computeKernelsClock(0);
+
+static size_t getComputeKernelsCapacity() {
+  static const size_t capacity =
+      std::stoul(util::getFromEnv("TACO_KERNEL_CACHE_CAPACITY", "4096"));
+  return capacity;
+}
+
+static bool shouldCacheKernels() {
+  return !std::getenv("CACHE_KERNELS") ||
+         std::string(std::getenv("CACHE_KERNELS")) != "0";
+}
+
+static string getKernelCacheKey(const IndexStmt stmt, bool assembleWhileCompute) {
+  return toCanonicalString(stmt) +
+         (assembleWhileCompute ? "; assembleWhileCompute" : "");
+}
+
+std::shared_ptr<Module> TensorBase::getComputeKernel(const IndexStmt stmt,
+                                                     bool assembleWhileCompute) {
+  const uint64_t hash =
+      util::fnv1a(getKernelCacheKey(stmt, assembleWhileCompute));
+  {
+    std::shared_lock<std::shared_timed_mutex> lock(computeKernelsMutex);
+    const auto bucket = computeKernels.find(hash);
+    if (bucket != computeKernels.end()) {
+      const auto bucketReverse =
+          util::ReverseConstIterable<KernelsCache::mapped_type>(bucket->second);
+      for (const auto& entry : bucketReverse) {
+        if (entry->assembleWhileCompute == assembleWhileCompute &&
+            isomorphic(stmt, entry->stmt)) {
+          entry->lastUse = ++computeKernelsClock;
+          return entry->kernel;
+        }
+      }
     }
   }
-  computeKernelsMutex.unlock();
+
+  // Fall back to kernels compiled by earlier processes.
+  const auto kernelModule = make_shared<Module>();
+  kernelModule->setCacheKey(getKernelCacheKey(stmt, assembleWhileCompute));
+  if (kernelModule->loadFromCache()) {
+    cacheComputeKernel(stmt, assembleWhileCompute, kernelModule);
+    return kernelModule;
+  }
   return nullptr;
 }
 
@@ -649,13 +714,78 @@ void TensorBase::accelerateOff(){
 }
 
 void TensorBase::cacheComputeKernel(const IndexStmt stmt,
+                                    bool assembleWhileCompute,
                                     const std::shared_ptr<Module> kernel) {
-  computeKernelsMutex.lock();
-  computeKernels.emplace_back(stmt, kernel);
-  computeKernelsMutex.unlock();
+  const uint64_t hash =
+      util::fnv1a(getKernelCacheKey(stmt, assembleWhileCompute));
+  const auto entry = std::make_shared<KernelsCacheEntry>(
+      stmt, assembleWhileCompute, kernel, ++computeKernelsClock);
+
+  std::unique_lock<std::shared_timed_mutex> lock(computeKernelsMutex);
+  computeKernels[hash].push_back(entry);
+  numComputeKernels++;
+
+  // Evict the least recently used kernels. The scan is linear, but it only
+  // happens after a kernel was compiled, which is far more expensive. Tensors
+  // that still use an evicted kernel keep it alive.
+  while (numComputeKernels > getComputeKernelsCapacity()) {
+    auto lruBucket = computeKernels.end();
+    size_t lruIndex = 0;
+    uint64_t lruTime = std::numeric_limits<uint64_t>::max();
+    for (auto bucket = computeKernels.begin(); bucket != computeKernels.end();
+         ++bucket) {
+      for (size_t i = 0; i < bucket->second.size(); i++) {
+        if (bucket->second[i]->lastUse < lruTime) {
+          lruTime = bucket->second[i]->lastUse;
+          lruBucket = bucket;
+          lruIndex = i;
+        }
+      }
+    }
+    lruBucket->second.erase(lruBucket->second.begin() + lruIndex);
+    if (lruBucket->second.empty()) {
+      computeKernels.erase(lruBucket);
+    }
+    numComputeKernels--;
+  }
 }
 
 void TensorBase::compile() {
+  waitForPendingCompile();
+  compileAssignment();
+}
+
+std::shared_future<void> TensorBase::compileAsync() {
+  waitForPendingCompile();
+  taco_uassert(getAssignment().defined()) << error::compile_without_expr;
+
+  // The thread holds a reference to the tensor so that it outlives the
+  // compilation. A promise is used rather than std::async since the last
+  // reference to a std::async future blocks until the thread finishes, which
+  // would deadlock if the thread itself dropped the last tensor reference.
+  std::promise<void> compiled;
+  content->pendingCompile = compiled.get_future().share();
+  TensorBase tensor = *this;
+  std::thread([tensor, compiled = std::move(compiled)]() mutable {
+    try {
+      tensor.compileAssignment();
+      compiled.set_value();
+    } catch (...) {
+      compiled.set_exception(std::current_exception());
+    }
+  }).detach();
+  return content->pendingCompile;
+}
+
+void TensorBase::waitForPendingCompile() {
+  if (content->pendingCompile.valid()) {
+    std::shared_future<void> pendingCompile = content->pendingCompile;
+    content->pendingCompile = std::shared_future<void>();
+    pendingCompile.get();
+  }
+}
+
+void TensorBase::compileAssignment() {
   Assignment assignment = getAssignment();
   taco_uassert(assignment.defined())
       << error::compile_without_expr;
@@ -704,7 +834,8 @@ void TensorBase::compile() {
 }
 
 void TensorBase::compileAccelerated(std::vector<IndexExpr> AcceleratedExpressions) {
- 
+  waitForPendingCompile();
+
   Assignment assignment = getAssignment();
   taco_uassert(assignment.defined())
       << error::compile_without_expr;
@@ -753,10 +884,10 @@ void TensorBase::compile(taco::IndexStmt stmt, bool assembleWhileCompute) {
   IndexStmt stmtToCompile = stmt.concretize();
   stmtToCompile = scalarPromote(stmtToCompile);
 
-  if (!std::getenv("CACHE_KERNELS") ||
-      std::string(std::getenv("CACHE_KERNELS")) != "0") {
+  if (shouldCacheKernels()) {
     concretizedAssign = stmtToCompile;
-    const auto cachedKernel = getComputeKernel(concretizedAssign);
+    const auto cachedKernel = getComputeKernel(concretizedAssign,
+                                               assembleWhileCompute);
     if (cachedKernel) {
       content->module = cachedKernel;
       return;
@@ -769,16 +900,32 @@ void TensorBase::compile(taco::IndexStmt stmt, bool assembleWhileCompute) {
   // the module we are holding on to could have been retrieved from the cache,
   // we can't modify it.
   content->module = make_shared<Module>();
+  if (shouldCacheKernels()) {
+    content->module->setCacheKey(getKernelCacheKey(concretizedAssign,
+                                                   assembleWhileCompute));
+  }
   content->module->addFunction(content->assembleFunc);
   content->module->addFunction(content->computeFunc);
   content->module->compile(); 
-  cacheComputeKernel(concretizedAssign, content->module);
+  cacheComputeKernel(concretizedAssign, assembleWhileCompute, content->module);
 }
 
 void TensorBase::compileAccelerated(taco::IndexStmt stmt, std::vector<FunctionInterface> functionInterface, bool assembleWhileCompute) {
   if (!needsCompile()) {
     return;
   }
+
+  // Reuse the schedule autotune picked for the expression, if any.
+  std::string description;
+  if (getAssignment().defined() &&
+      TuningDatabase::getDefault().lookup(getTuningKey(getAssignment(), functionInterface),
+                                          &description)) {
+    IndexStmt tuned = getTuningCandidate(getAssignment(), functionInterface, description);
+    if (tuned.defined()) {
+      compile(tuned, assembleWhileCompute);
+      return;
+    }
+  }
   setNeedsCompile(false);
 
   IndexStmt concretizedAssign = stmt;
@@ -789,10 +936,10 @@ void TensorBase::compileAccelerated(taco::IndexStmt stmt, std::vector<FunctionIn
 
   stmtToCompile = scalarPromote(stmtToCompile);
 
-  if (!std::getenv("CACHE_KERNELS") ||
-      std::string(std::getenv("CACHE_KERNELS")) != "0") {
+  if (shouldCacheKernels()) {
     concretizedAssign = stmtToCompile;
-    const auto cachedKernel = getComputeKernel(concretizedAssign);
+    const auto cachedKernel = getComputeKernel(concretizedAssign,
+                                               assembleWhileCompute);
     if (cachedKernel) {
       content->module = cachedKernel;
       return;
@@ -809,11 +956,76 @@ void TensorBase::compileAccelerated(taco::IndexStmt stmt, std::vector<FunctionIn
   // the module we are holding on to could have been retrieved from the cache,
   // we can't modify it.
   content->module = make_shared<Module>();
+  if (shouldCacheKernels()) {
+    content->module->setCacheKey(getKernelCacheKey(concretizedAssign,
+                                                   assembleWhileCompute));
+  }
   content->module->addFunction(content->assembleFunc);
   content->module->addFunction(content->computeFunc);
   // taco_uerror << content->module->getSource() << endl;
   content->module->compile();
-  cacheComputeKernel(concretizedAssign, content->module);
+  cacheComputeKernel(concretizedAssign, assembleWhileCompute, content->module);
+}
+
+std::string TensorBase::autotune(int warmup, int repetitions) {
+  waitForPendingCompile();
+  Assignment assignment = getAssignment();
+  taco_uassert(assignment.defined()) << error::compile_without_expr;
+  taco_uassert(warmup >= 0 && repetitions > 0)
+      << "Autotuning needs a non-negative warmup and at least one repetition";
+
+  std::vector<FunctionInterface> functionInterfaces = getRegisteredAccelerators();
+  std::vector<TuningCandidate> candidates =
+      getTuningCandidates(assignment, functionInterfaces);
+
+  std::string bestDescription;
+  double bestSeconds = std::numeric_limits<double>::infinity();
+  std::shared_ptr<Module> bestModule;
+  ir::Stmt bestAssembleFunc;
+  ir::Stmt bestComputeFunc;
+  for (auto& candidate : candidates) {
+    double seconds = std::numeric_limits<double>::infinity();
+    try {
+      setNeedsCompile(true);
+      compile(candidate.stmt, content->assembleWhileCompute);
+      for (int run = 0; run < warmup + repetitions; run++) {
+        setNeedsAssemble(true);
+        setNeedsCompute(true);
+        auto start = std::chrono::high_resolution_clock::now();
+        if (!assignment.getOperator().defined()) {
+          assemble();
+        }
+        compute();
+        auto end = std::chrono::high_resolution_clock::now();
+        if (run >= warmup) {
+          seconds = std::min(seconds, std::chrono::duration<double>(end - start).count());
+        }
+      }
+    } catch (TacoException&) {
+      // The schedule cannot be compiled or run here, e.g. because the
+      // library that implements an interface is not available.
+      continue;
+    }
+    if (seconds < bestSeconds) {
+      bestDescription = candidate.description;
+      bestSeconds = seconds;
+      bestModule = content->module;
+      bestAssembleFunc = content->assembleFunc;
+      bestComputeFunc = content->computeFunc;
+    }
+  }
+  taco_uassert(bestModule != nullptr) << "None of the schedules of " << assignment
+                           << " could be compiled and run";
+
+  TuningDatabase::getDefault().store(getTuningKey(assignment, functionInterfaces),
+                                     bestDescription);
+  content->module = bestModule;
+  content->assembleFunc = bestAssembleFunc;
+  content->computeFunc = bestComputeFunc;
+  setNeedsCompile(false);
+  setNeedsAssemble(true);
+  setNeedsCompute(true);
+  return bestDescription;
 }
 
 taco_tensor_t* TensorBase::getTacoTensorT() {
@@ -953,6 +1165,7 @@ vector<void*> packArguments(const TensorBase& tensor) {
 }
 
 void TensorBase::assemble() {
+  waitForPendingCompile();
   taco_uassert(!needsCompile()) << error::assemble_without_compile;
   if (!needsAssemble()) {
     return;
@@ -973,6 +1186,7 @@ void TensorBase::assemble() {
 }
 
 void TensorBase::compute() {
+  waitForPendingCompile();
   taco_uassert(!needsCompile()) << error::compute_without_compile;
   if (!needsCompute()) {
     return;
@@ -996,6 +1210,7 @@ void TensorBase::compute() {
 }
 
 std::vector<void*> TensorBase::compute_split() {
+  waitForPendingCompile();
   taco_uassert(!needsCompile()) << error::compute_without_compile;
   if (!needsCompute()) {
     return {};
@@ -1107,25 +1322,9 @@ void TensorBase::compileSource(std::string source) {
 TensorBase::HelperFuncsCache TensorBase::helperFunctions;
 std::mutex TensorBase::helperFunctionsMutex;
 
-std::shared_ptr<ir::Module>
-TensorBase::getHelperFunctions(const Format& format, Datatype ctype,
-                               const std::vector<int>& dimensions) {
-  helperFunctionsMutex.lock();
-  const auto helperFunctionsReverse =
-      util::ReverseConstIterable<TensorBase::HelperFuncsCache>(helperFunctions);
-  for (const auto& helperFuncs : helperFunctionsReverse) {
-    if (std::get<0>(helperFuncs) == format &&
-        std::get<1>(helperFuncs) == ctype &&
-        std::get<2>(helperFuncs) == dimensions) {
-      // If helper functions had already been generated for specified tensor
-      // format and type, then use cached version.
-      const auto helperFuncsModule = std::get<3>(helperFuncs);
-      helperFunctionsMutex.unlock();
-      return helperFuncsModule;
-    }
-  }
-  helperFunctionsMutex.unlock();
-
+static std::shared_ptr<Module>
+generateHelperFunctions(const Format& format, Datatype ctype,
+                        const std::vector<int>& dimensions) {
   std::shared_ptr<Module> helperModule = std::make_shared<Module>();
 
   std::function<Dimension(int)> getDim = [](int dim) {
@@ -1134,8 +1333,11 @@ TensorBase::getHelperFunctions(const Format& format, Datatype ctype,
   const auto dims = util::map(dimensions, getDim);
 
   if (format.getOrder() > 0) {
-    const Format bufferFormat = COO(format.getOrder(), false, true, false,
-                                    format.getModeOrdering());
+    Format bufferFormat = COO(format.getOrder(), false, true, false,
+                              format.getModeOrdering());
+    bufferFormat.setIndexType(format.getIndexType());
+    bufferFormat.setLevelArrayTypes(std::vector<std::vector<Datatype>>(
+        format.getOrder(), {format.getIndexType(), Int32}));
     TensorVar bufferTensor(Type(ctype, Shape(dims)), bufferFormat);
     TensorVar packedTensor(Type(ctype, Shape(dims)), format);
 
@@ -1169,7 +1371,9 @@ TensorBase::getHelperFunctions(const Format& format, Datatype ctype,
     helperModule->addFunction(lower(packStmt, "pack", true, true));
     helperModule->addFunction(lower(iterateStmt, "iterate", false, true));
   } else {
-    const Format bufferFormat = COO(1, false, true, false);
+    Format bufferFormat = COO(1, false, true, false);
+    bufferFormat.setIndexType(format.getIndexType());
+    bufferFormat.setLevelArrayTypes({{format.getIndexType(), Int32}});
     TensorVar bufferVector(Type(ctype, Shape({1})), bufferFormat);
     TensorVar packedScalar(Type(ctype, dims), format);
 
@@ -1186,14 +1390,60 @@ TensorBase::getHelperFunctions(const Format& format, Datatype ctype,
     helperModule->addFunction(lower(iterateStmt, "iterate", false, true));
   }
   helperModule->compile();
-
-  helperFunctionsMutex.lock();
-  helperFunctions.emplace_back(format, ctype, dimensions, helperModule);
-  helperFunctionsMutex.unlock();
-
   return helperModule;
 }
 
+std::shared_ptr<ir::Module>
+TensorBase::getHelperFunctions(const Format& format, Datatype ctype,
+                               const std::vector<int>& dimensions) {
+  std::shared_future<std::shared_ptr<Module>> helperFuncsModule;
+  std::promise<std::shared_ptr<Module>> generated;
+  {
+    std::lock_guard<std::mutex> lock(helperFunctionsMutex);
+    const auto helperFunctionsReverse =
+        util::ReverseConstIterable<TensorBase::HelperFuncsCache>(helperFunctions);
+    for (const auto& helperFuncs : helperFunctionsReverse) {
+      if (std::get<0>(helperFuncs) == format &&
+          std::get<1>(helperFuncs) == ctype &&
+          std::get<2>(helperFuncs) == dimensions) {
+        // If helper functions had already been generated (or are being
+        // generated by another thread) for specified tensor format and type,
+        // then use cached version.
+        helperFuncsModule = std::get<3>(helperFuncs);
+        break;
+      }
+    }
+    if (!helperFuncsModule.valid()) {
+      helperFunctions.emplace_back(format, ctype, dimensions,
+                                   generated.get_future().share());
+    }
+  }
+  if (helperFuncsModule.valid()) {
+    return helperFuncsModule.get();
+  }
+
+  try {
+    std::shared_ptr<Module> helperModule =
+        generateHelperFunctions(format, ctype, dimensions);
+    generated.set_value(helperModule);
+    return helperModule;
+  } catch (...) {
+    // Let the next caller try again rather than caching the failure
+    {
+      std::lock_guard<std::mutex> lock(helperFunctionsMutex);
+      for (auto it = helperFunctions.begin(); it != helperFunctions.end(); ++it) {
+        if (std::get<0>(*it) == format && std::get<1>(*it) == ctype &&
+            std::get<2>(*it) == dimensions) {
+          helperFunctions.erase(it);
+          break;
+        }
+      }
+    }
+    generated.set_exception(std::current_exception());
+    throw;
+  }
+}
+
 template<typename T>
 bool isZero(T a) {
   if ((double)a == 0.0) {
@@ -1444,6 +1694,9 @@ TensorBase dispatchRead(T& file, FileType filetype, U format, bool pack) {
     case FileType::rb:
       tensor = readRB(file, format, pack);
       break;
+    case FileType::tbin:
+      tensor = readBinary(file, format, pack);
+      break;
   }
   return tensor;
 }
@@ -1465,6 +1718,9 @@ TensorBase dispatchRead(std::string filename, U format, bool pack) {
   else if (extension == "rb") {
     tensor = dispatchRead(filename, FileType::rb, format, pack);
   }
+  else if (extension == "tbin") {
+    tensor = dispatchRead(filename, FileType::tbin, format, pack);
+  }
   else {
     taco_uerror << "File extension not recognized: " << filename << std::endl;
   }
@@ -1516,6 +1772,9 @@ void dispatchWrite(T& file, const TensorBase& tensor, FileType filetype) {
     case FileType::rb:
       writeRB(file, tensor);
       break;
+    case FileType::tbin:
+      writeBinary(file, tensor);
+      break;
   }
 }
 
@@ -1536,6 +1795,9 @@ void write(string filename, const TensorBase& tensor) {
   else if (extension == "rb") {
     dispatchWrite(filename, tensor, FileType::rb);
   }
+  else if (extension == "tbin") {
+    dispatchWrite(filename, tensor, FileType::tbin);
+  }
   else {
     taco_uerror << "File extension not recognized: " << filename << std::endl;
   }
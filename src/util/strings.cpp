@@ -44,4 +44,19 @@ string fill(string text, char fill, size_t n) {
   return string(prefix,fill) + " " + text + " " + string(suffix,fill);
 }
 
+uint64_t fnv1a(const string& str) {
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (unsigned char c : str) {
+    hash ^= c;
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+string fnv1aHex(const string& str) {
+  stringstream ss;
+  ss << hex << setw(16) << setfill('0') << fnv1a(str);
+  return ss.str();
+}
+
 }}
@@ -175,6 +175,53 @@ TEST(accelerateNotation, testCCLTimeStardust) {
 
 }
 
+TEST(accelerateNotation, nativeSMTSolver) {
+    DynamicOrder dynamicOrder;
+    DynamicIndexIterator interator(dynamicOrder);
+    IndexVar var("w"), var2("x"), var3("y"), var4("z");
+
+    std::map<DynamicOrder, std::vector<IndexVar>> mapRef;
+    std::map<IndexVar, int> dimRef;
+    mapRef[dynamicOrder] = {var, var2};
+    dimRef[var] = 10;
+    dimRef[var2] = 10;
+    dimRef[var3] = 20;
+    dimRef[var4] = 20;
+
+    // Tile sizes are positive and smaller than their dimension.
+    GenerateSMTCode bounds(forall(interator, dynamicOrder(interator) > 4), mapRef, dimRef, true);
+    ASSERT_TRUE(bounds.isSat());
+    std::map<IndexVar, int> tilings = bounds.getTilings();
+    ASSERT_EQ(9, tilings.at(var));
+    ASSERT_EQ(9, tilings.at(var2));
+
+    GenerateSMTCode divisible(exists(interator, dynamicOrder(interator) / 4 * 4 + 3 == dynamicOrder(interator)) &&
+                              (DynamicExpr(var) * DynamicExpr(var2) < 30), mapRef, dimRef, true);
+    tilings = divisible.getTilings();
+    ASSERT_EQ(2, (int) tilings.size());
+    ASSERT_TRUE(tilings.at(var) % 4 == 3 || tilings.at(var2) % 4 == 3);
+    ASSERT_EQ(28, tilings.at(var) * tilings.at(var2));
+
+    // 2^14 only factors into powers of two below the dimensions as 8*8*16*16.
+    GenerateSMTCode product(((DynamicExpr(var) * DynamicExpr(var2) * DynamicExpr(var3) * DynamicExpr(var4)) == 16384),
+                            {}, dimRef, true);
+    tilings = product.getTilings();
+    ASSERT_EQ(8, tilings.at(var));
+    ASSERT_EQ(8, tilings.at(var2));
+    ASSERT_EQ(16, tilings.at(var3));
+    ASSERT_EQ(16, tilings.at(var4));
+
+    GenerateSMTCode unsat(forall(interator, interator > interator), mapRef, dimRef, true);
+    ASSERT_FALSE(unsat.isSat());
+    ASSERT_TRUE(unsat.getTilings().empty());
+
+    // Without tiling, every variable is fixed to its dimension.
+    GenerateSMTCode exact(DynamicExpr(var) + DynamicExpr(var3) == 30, {}, dimRef, false);
+    ASSERT_TRUE(exact.isSat());
+    GenerateSMTCode inexact(DynamicExpr(var) + DynamicExpr(var3) == 29, {}, dimRef, false);
+    ASSERT_FALSE(inexact.isSat());
+}
+
 bool checker_function(int tile){
   if (tile < 16) return true;
   return false;
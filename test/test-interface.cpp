@@ -409,6 +409,47 @@ TEST(interface, tiledMMInterface) {
    ASSERT_TENSOR_EQ(expected, A);
 }
 
+TEST(interface, tiledMMInterfaceRemainder) {
+
+   // 5 is not a multiple of the tile size, so the last tile of every index
+   // variable is computed by generated code instead of the interface.
+   Tensor<float> A("A", {5, 5}, Format{Dense, Dense});
+   Tensor<float> B("B", {5, 5}, Format{Dense, Dense});
+   Tensor<float> C("C", {5, 5}, Format{Dense, Dense});
+   Tensor<float> expected("expected", {5, 5}, Format{Dense, Dense});
+
+   for (int i = 0; i < 5; i++) {
+      for (int j = 0; j < 5; j++) {
+         C.insert({i, j}, (float) i+j);
+         B.insert({i, j}, (float) i+j);
+      }
+   }
+
+   B.pack();
+   C.pack();
+
+   IndexVar i("i");
+   IndexVar j("j");
+   IndexVar k("k");
+
+   IndexExpr accelerateExpr = B(i, j) * C(j, k);
+   A(i, k) = accelerateExpr;
+
+   IndexStmt stmt = A.getAssignment().concretize();
+   stmt = stmt.tile(new MatrixMultiply(), accelerateExpr, {{i, 2}, {j, 2}, {k, 2}});
+
+   A.compile(stmt);
+   A.assemble();
+   A.compute();
+
+   expected(i, k) = accelerateExpr;
+   expected.compile();
+   expected.assemble();
+   expected.compute();
+
+   ASSERT_TENSOR_EQ(expected, A);
+}
+
 TEST(interface, sampleSplitExample) {
 
 
@@ -577,6 +618,140 @@ TEST(interface, dimReduceSaxpy) {
    ASSERT_TENSOR_EQ(expected, A);
 }
 
+TEST(interface, dimReduceSaxpyBatched) {
+
+   Tensor<float> A("A", {16, 8}, Format{Dense, Dense}, 0);
+   Tensor<float> B("B", {16, 8}, Format{Dense, Dense});
+   Tensor<float> C("C", {16, 8}, Format{Dense, Dense});
+   Tensor<float> expected("expected", {16, 8}, Format{Dense, Dense});
+
+   TensorVar precomputed("precomputed", Type(taco::Float32, {16, 8}), Format{Dense, Dense});
+
+   for (int i = 0; i < 16; i++) {
+      for (int j = 0; j < 8; j++) {
+         B.insert({i, j}, (float) i + 2 * j);
+         C.insert({i, j}, (float) 3 * i + j);
+      }
+   }
+
+   B.pack();
+   C.pack();
+
+   IndexVar i("i");
+   IndexVar j("j");
+
+   // The rows of B and C are stored one after the other, so the calls made
+   // for every row are coalesced into one strided-batched call
+   IndexExpr accelerateExpr = B(i, j) + C(i, j);
+   A(i, j) = accelerateExpr;
+
+   IndexStmt stmt = A.getAssignment().concretize();
+   stmt = stmt.holdConstant(new Saxpy(), accelerateExpr, {i}, precomputed(i, j));
+   ASSERT_FALSE(isa<DimReduction>(stmt));
+   A.compile(stmt);
+   A.assemble();
+   A.compute();
+
+   expected(i, j) = accelerateExpr;
+   expected.compile();
+   expected.assemble();
+   expected.compute();
+
+   ASSERT_TENSOR_EQ(expected, A);
+}
+
+TEST(interface, dimReduceSaxpyColumnMajor) {
+
+   Tensor<float> A("A", {16, 16}, Format{Dense, Dense}, 0);
+   Tensor<float> B("B", {16, 16}, Format({Dense, Dense}, {1, 0}));
+   Tensor<float> C("C", {16, 16}, Format{Dense, Dense});
+   Tensor<float> expected("expected", {16, 16}, Format{Dense, Dense});
+
+   TensorVar precomputed("precomputed", Type(taco::Float32, {16, 16}), Format{Dense, Dense});
+
+   for (int i = 0; i < 16; i++) {
+      for (int j = 0; j < 16; j++) {
+         B.insert({i, j}, (float) i + 2 * j);
+         C.insert({i, j}, (float) 3 * i + j);
+      }
+   }
+
+   B.pack();
+   C.pack();
+
+   IndexVar i("i");
+   IndexVar j("j");
+
+   // The columns of B are passed to the interface in place, while the columns
+   // of C are gathered into a temporary
+   IndexExpr accelerateExpr = B(i, j) + C(i, j);
+   A(i, j) = accelerateExpr;
+
+   IndexStmt stmt = A.getAssignment().concretize();
+   stmt = stmt.holdConstant(new Saxpy(), accelerateExpr, {j}, precomputed(i, j));
+   ASSERT_TRUE(isa<DimReduction>(stmt));
+   ASSERT_EQ(1u, to<DimReduction>(stmt).getAliases().size());
+   A.compile(stmt);
+   A.assemble();
+   A.compute();
+
+   expected(i, j) = accelerateExpr;
+   expected.compile();
+   expected.assemble();
+   expected.compute();
+
+   ASSERT_TENSOR_EQ(expected, A);
+}
+
+TEST(interface, dimReduceSdotParallel) {
+
+   Tensor<float> A("A", {16}, Format{Dense}, 0);
+   Tensor<float> B("B", {16, 16}, Format{Dense, Dense});
+   Tensor<float> C("C", {16}, Format{Dense});
+   Tensor<float> expected("expected", {16}, Format{Dense});
+
+   TensorVar precomputed("precomputed", Type(taco::Float32, {16}), Format{Dense});
+
+   for (int i = 0; i < 16; i++) {
+      C.insert({i}, (float) i);
+      for (int j = 0; j < 16; j++) {
+         B.insert({i, j}, (float) i + 2 * j);
+      }
+   }
+
+   B.pack();
+   C.pack();
+
+   IndexVar i("i");
+   IndexVar j("j");
+
+   // Every thread gathers the columns of B it calls the function on into its
+   // own copy of the temporary
+   IndexExpr accelerateExpr = B(i, j) * C(i);
+   A(j) = accelerateExpr;
+
+   IndexStmt stmt = A.getAssignment().concretize();
+   stmt = stmt.holdConstant(new Sdot(), accelerateExpr, {j}, precomputed(j));
+   stmt = stmt.parallelize(j, ParallelUnit::CPUThread, OutputRaceStrategy::NoRaces);
+
+   A.compile(stmt);
+   A.assemble();
+   A.compute();
+
+   expected(j) = accelerateExpr;
+   expected.compile();
+   expected.assemble();
+   expected.compute();
+
+   ASSERT_TENSOR_EQ(expected, A);
+
+   // Calls to functions that are not thread safe cannot be parallelized
+   IndexStmt unsafe = A.getAssignment().concretize();
+   unsafe = unsafe.holdConstant(new TblisDot(), accelerateExpr, {j}, precomputed(j));
+   ASSERT_THROW(unsafe.parallelize(j, ParallelUnit::CPUThread, OutputRaceStrategy::NoRaces),
+                taco::TacoException);
+}
+
 TEST(interface, cblasSgmev) {
 
    // actual computation
@@ -1739,6 +1914,87 @@ TEST(interface, tiledSaxpyAVX) {
 }
 
 
+TEST(interface, tiledSaxpyAVXRemainder) {
+
+   gsl_compile = false;
+
+   Tensor<float> A("A", {20}, Format{Dense});
+   Tensor<float> expected("expected", {20}, Format{Dense});
+   Tensor<float> B("B", {20}, Format{Dense});
+   Tensor<float> C("C", {20}, Format{Dense});
+   IndexVar i("i");
+
+   for (int i = 0; i < 20; i++) {
+      C.insert({i}, (float) i);
+      B.insert({i}, (float) 2*i);
+   }
+
+   C.pack();
+   B.pack();
+
+   IndexExpr accelerateExpr = B(i) + C(i);
+   A(i) = accelerateExpr;
+   IndexStmt stmt = A.getAssignment().concretize();
+   stmt = stmt.tile(new AVXSaxpy(), accelerateExpr, {{i,  8}});
+
+   A.compile(stmt);
+   A.assemble();
+   A.compute();
+
+   expected(i) = accelerateExpr;
+   expected.compile();
+   expected.assemble();
+   expected.compute();
+
+   ASSERT_TENSOR_EQ(expected, A);
+}
+
+
+TEST(interface, tiledSIMDAddFamily) {
+
+   gsl_compile = false;
+
+   ASSERT_EQ(getSIMDVectorWidth(getHostSIMDInstructionSet()), SIMDAdd().getVectorWidth());
+
+   for (SIMDInstructionSet instructionSet : {SIMDInstructionSet::SSE,
+                                             SIMDInstructionSet::AVX2,
+                                             SIMDInstructionSet::AVX512}) {
+      Tensor<float> A("A", {40}, Format{Dense});
+      Tensor<float> expected("expected", {40}, Format{Dense});
+      Tensor<float> B("B", {40}, Format{Dense});
+      Tensor<float> C("C", {40}, Format{Dense});
+      IndexVar i("i");
+
+      for (int i = 0; i < 40; i++) {
+         C.insert({i}, (float) i);
+         B.insert({i}, (float) 3*i);
+      }
+
+      C.pack();
+      B.pack();
+
+      SIMDAdd* simdAdd = new SIMDAdd(instructionSet);
+      int width = simdAdd->getVectorWidth();
+
+      IndexExpr accelerateExpr = B(i) + C(i);
+      A(i) = accelerateExpr;
+      IndexStmt stmt = A.getAssignment().concretize();
+      stmt = stmt.tile(simdAdd, accelerateExpr, {{i,  width}});
+
+      A.compile(stmt);
+      A.assemble();
+      A.compute();
+
+      expected(i) = accelerateExpr;
+      expected.compile();
+      expected.assemble();
+      expected.compute();
+
+      ASSERT_TENSOR_EQ(expected, A);
+   }
+}
+
+
 TEST(interface, sdmmCblasDot){
 
   int dim = 16;
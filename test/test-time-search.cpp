@@ -1,5 +1,6 @@
 #include <cassert>
 #include <cstdint>
+#include <cstdlib>
 #include <iostream>
 #include <vector>
 #include <taco/index_notation/transformations.h>
@@ -15,6 +16,8 @@
 #include "taco/lower/lower.h"
 #include "taco/ir_tags.h"
 #include "taco/error/error_messages.h"
+#include "taco/accelerator_notation/autotune.h"
+#include "taco/util/env.h"
 
 #include "taco/accelerator_interface/cblas_interface.h"
 #include "taco/accelerator_interface/tblis_interface.h"
@@ -289,4 +292,95 @@ TEST(time, timeEndToEndMMSDDMM) {
    A.compile();
    A.assemble();
 
-}
\ No newline at end of file
+}
+TEST(time, autoAccelerateStats) {
+
+   int NUM_K = 10;
+
+   Tensor<float> A("A", {NUM_K}, {taco::Dense});
+   Tensor<float> B("B", {NUM_K}, {taco::Dense});
+   Tensor<float> C("C", {NUM_K}, {taco::Dense});
+
+   IndexVar i("i");
+
+   A(i) = B(i) + C(i);
+
+   FunctionInterface saxpy = new Saxpy();
+   IndexStmt stmt = makeReductionNotation(A.getAssignment());
+
+   AutoAccelerateStats stats;
+   std::vector<IndexStmt> candidates = stmt.autoAccelerate(stmt, {saxpy, new Sdot()}, &stats);
+
+   // The first candidate is the statement itself, followed by one candidate
+   // for each distinct rewrite.
+   ASSERT_EQ(candidates.size(), stats.candidates);
+   ASSERT_EQ(1 + stats.uniqueRewrites, stats.candidates);
+   ASSERT_LE(stats.uniqueRewrites, stats.rewrites);
+   ASSERT_GE(stats.seconds, 0);
+
+   bool mappedToSaxpy = false;
+   for (auto& mapping : stats.mappings) {
+      mappedToSaxpy |= mapping.second == saxpy.getNode()->getFunctionName();
+   }
+   ASSERT_TRUE(mappedToSaxpy);
+
+}
+
+TEST(time, autotune) {
+
+   int NUM_I = 256;
+
+   Tensor<float> A("A", {NUM_I}, {taco::Dense});
+   Tensor<float> B("B", {NUM_I}, {taco::Dense});
+   Tensor<float> C("C", {NUM_I}, {taco::Dense});
+   Tensor<float> expected("expected", {NUM_I}, {taco::Dense});
+
+   for (int i = 0; i < NUM_I; i++) {
+      B.insert({i}, (float) i);
+      C.insert({i}, (float) 2 * i);
+   }
+   B.pack();
+   C.pack();
+
+   IndexVar i("i");
+   A(i) = B(i) + C(i);
+   expected(i) = B(i) + C(i);
+   expected.evaluate();
+
+   FunctionInterface saxpy = new Saxpy();
+   A.registerAccelerator(saxpy);
+
+   // The default schedule is always a candidate, followed by the mappings.
+   std::vector<TuningCandidate> candidates =
+      getTuningCandidates(A.getAssignment(), {saxpy});
+   ASSERT_FALSE(candidates.empty());
+   ASSERT_EQ("default", candidates[0].description);
+
+   std::string path = util::getTmpdir() + "tuning.db";
+   setenv("TACO_TUNING_DATABASE", path.c_str(), 1);
+   TuningDatabase::getDefault().clear();
+
+   std::string description = A.autotune(0, 2);
+   A.assemble();
+   A.compute();
+   ASSERT_TENSOR_EQ(expected, A);
+
+   // The decision is persistent.
+   std::string key = getTuningKey(A.getAssignment(), {saxpy});
+   std::string stored;
+   ASSERT_TRUE(TuningDatabase(path).lookup(key, &stored));
+   ASSERT_EQ(description, stored);
+
+   // Another tensor with an expression of the same shape reuses it.
+   Tensor<float> D("D", {NUM_I}, {taco::Dense});
+   D(i) = C(i) + B(i);
+   ASSERT_EQ(key, getTuningKey(D.getAssignment(), {saxpy}));
+   D.registerAccelerator(saxpy);
+   D.compileAccelerated({});
+   D.assemble();
+   D.compute();
+   ASSERT_TENSOR_EQ(expected, D);
+
+   TuningDatabase::getDefault().clear();
+   unsetenv("TACO_TUNING_DATABASE");
+}
@@ -7,6 +7,7 @@
 #include "taco/format.h"
 #include "taco/index_notation/index_notation.h"
 #include "taco/storage/storage.h"
+#include "taco/storage/sell.h"
 #include "taco/util/strings.h"
 
 using namespace taco;
@@ -72,3 +73,234 @@ TEST(format, dense) {
   A.pack();
   ASSERT_COMPONENTS_EQUALS({{{3}}, {{3}}}, {0,2,0, 0,0,0, 3,0,4}, A);
 }
+
+TEST(format, bcsr) {
+  Format bcsr = BCSR(2,3);
+  ASSERT_EQ(4, bcsr.getOrder());
+  ASSERT_EQ(2, bcsr.getModeFormats()[2].getFixedSize());
+  ASSERT_EQ(3, bcsr.getModeFormats()[3].getFixedSize());
+  ASSERT_EQ(0, bcsr.getModeFormats()[1].getFixedSize());
+  ASSERT_EQ(BCSR(2,3), bcsr);
+  ASSERT_NE(BCSR(2,2), bcsr);
+  ASSERT_NE(Format({Dense,Sparse,Dense,Dense}), bcsr);
+  ASSERT_THROW(Tensor<double>({2,2,3,3}, bcsr), TacoException);
+
+  // A 4x6 matrix with two nonzero 2x3 blocks
+  Tensor<double> A("A", {2,2,2,3}, bcsr);
+  Tensor<double> B("B", {2,2,2,3}, Format({Dense,Sparse,Dense,Dense}));
+  for (int bi = 0; bi < 2; bi++) {
+    for (int bj = 0; bj < 3; bj++) {
+      A.insert({0,1,bi,bj}, (double)(bi*3 + bj + 1));
+      B.insert({0,1,bi,bj}, (double)(bi*3 + bj + 1));
+      A.insert({1,0,bi,bj}, (double)(bi - bj));
+      B.insert({1,0,bi,bj}, (double)(bi - bj));
+    }
+  }
+  A.pack();
+  B.pack();
+
+  // Each block is stored contiguously in the values
+  double* vals = (double*)A.getStorage().getValues().getData();
+  for (int i = 0; i < 6; i++) {
+    ASSERT_EQ((double)(i + 1), vals[i]);
+  }
+
+  Tensor<double> x("x", {2,3}, Format({Dense,Dense}));
+  for (int j = 0; j < 2; j++) {
+    for (int bj = 0; bj < 3; bj++) {
+      x.insert({j,bj}, (double)(j*3 + bj));
+    }
+  }
+  x.pack();
+
+  IndexVar i, j, bi, bj;
+  Tensor<double> y("y", {2,2}, Format({Dense,Dense}));
+  y(i,bi) = A(i,j,bi,bj) * x(j,bj);
+  Tensor<double> expected("expected", {2,2}, Format({Dense,Dense}));
+  expected(i,bi) = B(i,j,bi,bj) * x(j,bj);
+  expected.evaluate();
+  y.compile();
+  y.assemble();
+  y.compute();
+  ASSERT_TENSOR_EQ(expected, y);
+}
+
+TEST(format, bcsf) {
+  Format bcsf = BCSF({2,2,2});
+  ASSERT_EQ(6, bcsf.getOrder());
+  ASSERT_EQ(Sparse, bcsf.getModeFormats()[2]);
+  ASSERT_EQ(2, bcsf.getModeFormats()[5].getFixedSize());
+
+  Tensor<double> A("A", {3,3,3,2,2,2}, bcsf);
+  A.insert({2,0,1,1,0,1}, 1.0);
+  A.insert({0,1,2,0,0,0}, 2.0);
+  A.pack();
+
+  IndexVar i, j, k, bi, bj, bk;
+  Tensor<double> s("s", {3,2}, Format({Dense,Dense}));
+  s(i,bi) = A(i,j,k,bi,bj,bk);
+  s.evaluate();
+  Tensor<double> expected("expected", {3,2}, Format({Dense,Dense}));
+  expected.insert({2,1}, 1.0);
+  expected.insert({0,0}, 2.0);
+  expected.pack();
+  ASSERT_TENSOR_EQ(expected, s);
+}
+
+TEST(format, sell) {
+  // A 7x6 matrix with rows of 3, 0, 1, 6, 2, 0 and 1 nonzeros
+  Tensor<double> A("A", {7,6}, CSR);
+  A.insert({0,0}, 1.0);
+  A.insert({0,2}, 2.0);
+  A.insert({0,5}, 3.0);
+  A.insert({2,4}, 4.0);
+  for (int j = 0; j < 6; j++) {
+    A.insert({3,j}, (double)(j + 5));
+  }
+  A.insert({4,1}, 11.0);
+  A.insert({4,3}, 12.0);
+  A.insert({6,2}, 13.0);
+  A.pack();
+
+  std::vector<int> permutation;
+  TensorBase S = packSELL(A, 4, 8, &permutation);
+  ASSERT_EQ(SELL(4), S.getFormat());
+  ASSERT_EQ(std::vector<int>({2,6,4,6}), S.getDimensions());
+  ASSERT_EQ(std::vector<int>({3,0,4,2,6,1,5,-1}), permutation);
+
+  // Slices are padded to their longest row and store their rows interleaved
+  ASSERT_EQ(4u*6 + 4*1, S.getStorage().getValues().getSize());
+  double* vals = (double*)S.getStorage().getValues().getData();
+  ASSERT_EQ(std::vector<double>({5,1,11,4, 6,2,12,0}),
+            std::vector<double>(vals, vals + 8));
+
+  Tensor<double> x("x", {6}, Format({Dense}));
+  for (int j = 0; j < 6; j++) {
+    x.insert({j}, (double)(j + 1));
+  }
+  x.pack();
+
+  IndexVar i, j, k, s, c;
+  Tensor<double> expected("expected", {7}, Format({Dense}));
+  expected(i) = A(i,j) * x(j);
+  expected.evaluate();
+
+  Tensor<double> y("y", {2,4}, Format({Dense,Dense}));
+  y(s,c) = S(s,k,c,j) * x(j);
+  y.evaluate();
+  for (int r = 0; r < 8; r++) {
+    if (permutation[r] >= 0) {
+      double actual = y.at({r / 4, r % 4});
+      ASSERT_EQ(expected.at({permutation[r]}), actual);
+    }
+  }
+}
+
+TEST(format, hashed) {
+  ASSERT_NE(Hashed(8), Hashed(16));
+  ASSERT_EQ(8, Hashed(8).getTableSize(5));
+  ASSERT_EQ(5, Hashed().getTableSize(5));
+
+  Tensor<double> B("B", {4,5}, CSR);
+  B.insert({0,1}, 1.0);
+  B.insert({0,4}, 2.0);
+  B.insert({2,0}, 3.0);
+  B.insert({3,3}, 4.0);
+  B.pack();
+  Tensor<double> C("C", {5,6}, CSR);
+  C.insert({0,2}, 5.0);
+  C.insert({1,5}, 6.0);
+  C.insert({3,0}, 7.0);
+  C.insert({4,5}, 8.0);
+  C.insert({4,1}, 9.0);
+  C.pack();
+
+  IndexVar i, j, k;
+  Tensor<double> expected("expected", {4,6}, Format({Dense,Dense}));
+  expected(i,j) = B(i,k) * C(k,j);
+  expected.evaluate();
+
+  for (const Format& format : {Format({Dense,Hashed(8)}),
+                               Format({Dense,Hashed()})}) {
+    Tensor<double> A("A", {4,6}, format);
+    A(i,j) = B(i,k) * C(k,j);
+    A.evaluate();
+
+    Tensor<double> actual("actual", {4,6}, Format({Dense,Dense}));
+    actual(i,j) = A(i,j);
+    actual.evaluate();
+    ASSERT_TENSOR_EQ(expected, actual);
+
+    // Convert the hash tables to CSR
+    Tensor<double> csr = A.removeExplicitZeros(CSR);
+    ASSERT_EQ(4u, csr.getStorage().getValues().getSize());
+    ASSERT_TENSOR_EQ(expected, csr);
+  }
+}
+
+TEST(format, bitmap) {
+  // Span several words per bitset
+  const int n = 130;
+  Tensor<double> b("b", {n}, Format({Bitmap}));
+  Tensor<double> c("c", {n}, Format({Bitmap}));
+  Tensor<double> bDense("bDense", {n}, Format({Dense}));
+  Tensor<double> cDense("cDense", {n}, Format({Dense}));
+  for (int i = 0; i < n; i += 3) {
+    b.insert({i}, (double)i);
+    bDense.insert({i}, (double)i);
+  }
+  for (int i = 0; i < n; i += 5) {
+    c.insert({i}, (double)(i + 1));
+    cDense.insert({i}, (double)(i + 1));
+  }
+  b.pack();
+  c.pack();
+  bDense.pack();
+  cDense.pack();
+  ASSERT_EQ(44u, b.getStorage().getValues().getSize());
+  ASSERT_TENSOR_EQ(bDense, b);
+
+  IndexVar i, j;
+  Tensor<double> expected("expected", {n}, Format({Dense}));
+  expected(i) = bDense(i) * cDense(i);
+  expected.evaluate();
+  Tensor<double> mul("mul", {n}, Format({Dense}));
+  mul(i) = b(i) * c(i);
+  mul.evaluate();
+  ASSERT_TENSOR_EQ(expected, mul);
+
+  expected(i) = bDense(i) + cDense(i);
+  expected.evaluate();
+  Tensor<double> add("add", {n}, Format({Dense}));
+  add(i) = b(i) + c(i);
+  add.evaluate();
+  ASSERT_TENSOR_EQ(expected, add);
+
+  // Sparse matrix-vector multiplication with a bitmap matrix
+  Tensor<double> A("A", {4,n}, Format({Dense,Bitmap}));
+  Tensor<double> ADense("ADense", {4,n}, Format({Dense,Dense}));
+  for (int r = 0; r < 4; r++) {
+    for (int k = r; k < n; k += 7 + r) {
+      A.insert({r,k}, (double)(r + k));
+      ADense.insert({r,k}, (double)(r + k));
+    }
+  }
+  A.pack();
+  ADense.pack();
+  Tensor<double> y("y", {4}, Format({Dense}));
+  y(i) = A(i,j) * c(j);
+  y.evaluate();
+  Tensor<double> yExpected("yExpected", {4}, Format({Dense}));
+  yExpected(i) = ADense(i,j) * cDense(j);
+  yExpected.evaluate();
+  ASSERT_TENSOR_EQ(yExpected, y);
+
+  // Assemble a bitmap result
+  Tensor<double> C("C", {4,n}, Format({Dense,Bitmap}));
+  C(i,j) = A(i,j) * c(j);
+  C.evaluate();
+  Tensor<double> CExpected("CExpected", {4,n}, Format({Dense,Dense}));
+  CExpected(i,j) = ADense(i,j) * cDense(j);
+  CExpected.evaluate();
+  ASSERT_TENSOR_EQ(CExpected, C);
+}
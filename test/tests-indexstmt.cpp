@@ -85,3 +85,18 @@ TEST(indexstmt, spmm) {
 
 
 
+
+TEST(indexstmt, canonicalString) {
+  Type t(type<double>(), {3});
+  TensorVar a("a", t, Sparse), b("b", t, Sparse), c("c", t, Sparse);
+  TensorVar x("x", t, Sparse), y("y", t, Sparse), z("z", t, Sparse);
+  TensorVar d("d", t, Dense);
+  IndexVar l("l");
+
+  ASSERT_EQ(toCanonicalString(forall(i, a(i) = b(i) + c(i))),
+            toCanonicalString(forall(l, x(l) = y(l) + z(l))));
+  ASSERT_NE(toCanonicalString(forall(i, a(i) = b(i) + c(i))),
+            toCanonicalString(forall(i, a(i) = b(i) * c(i))));
+  ASSERT_NE(toCanonicalString(forall(i, a(i) = b(i) + c(i))),
+            toCanonicalString(forall(i, a(i) = b(i) + d(i))));
+}
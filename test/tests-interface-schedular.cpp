@@ -1,5 +1,7 @@
 #include <cassert>
 #include <cstdint>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <vector>
 #include <taco/index_notation/transformations.h>
@@ -15,9 +17,11 @@
 #include "taco/accelerator_notation/accelerator_notation_visitor.h"
 #include "taco/accelerator_notation/accelerator_notation_nodes.h"
 #include "taco/accelerator_notation/interface_schedular.h"
+#include "taco/accelerator_notation/cost_model.h"
 #include "taco/lower/lower.h"
 #include "taco/ir_tags.h"
 #include "taco/error/error_messages.h"
+#include "taco/util/env.h"
 
 #include "taco/accelerator_interface/cblas_interface.h"
 #include "taco/accelerator_interface/test_interface.h"
@@ -83,4 +87,60 @@ TEST(iSchedular, testDummp){
       piles.pop();
     }
 
-}
\ No newline at end of file
+}
+
+struct PreferInterfaces : public CostModel {
+    double estimate(const AcceleratedCandidate& candidate) const {
+      return 1.0 / (1 + candidate.mappings.size());
+    }
+};
+
+TEST(iSchedular, costModel){
+
+    int NUM_I = 1024;
+
+    Tensor<float> A("A", {NUM_I}, {taco::Dense});
+    Tensor<float> B("B", {NUM_I}, {taco::Dense});
+    Tensor<float> C("C", {NUM_I}, {taco::Dense});
+
+    IndexVar i("i");
+
+    A(i) = B(i) + C(i);
+
+    FunctionInterface saxpy = new Saxpy();
+    std::string saxpyName = saxpy.getNode()->getFunctionName();
+    IndexStmt stmt = makeReductionNotation(A.getAssignment());
+
+    // One add for every element, and every tensor is read or written once.
+    Work work = getWork(stmt);
+    ASSERT_EQ(NUM_I, work.flops);
+    ASSERT_EQ(3 * NUM_I * sizeof(float), work.bytes);
+
+    std::vector<AcceleratedCandidate> candidates =
+        stmt.autoAccelerateCandidates(stmt, {saxpy});
+    ASSERT_TRUE(candidates[0].mappings.empty());
+
+    AnalyticalCostModel model;
+    AcceleratedCandidate best = selectAccelerated(stmt, {saxpy}, model);
+    for (auto& candidate : candidates) {
+      ASSERT_LE(model.estimate(best), model.estimate(candidate));
+    }
+
+    // A candidate that calls saxpy is picked when interfaces are preferred.
+    AcceleratedCandidate mapped = selectAccelerated(stmt, {saxpy}, PreferInterfaces());
+    ASSERT_FALSE(mapped.mappings.empty());
+    ASSERT_EQ(saxpyName, mapped.mappings[0].second.getNode()->getFunctionName());
+
+    // A slow calibrated interface makes the generated code the best choice.
+    std::string path = util::getTmpdir() + "/calibration.txt";
+    {
+      std::ofstream file(path);
+      file << "# function flops/s" << std::endl;
+      file << saxpyName << " 1e3" << std::endl;
+    }
+    model.loadCalibration(path);
+    std::remove(path.c_str());
+    ASSERT_EQ(1e3, model.getFlopRate(saxpyName));
+    ASSERT_LT(model.estimate(candidates[0]), model.estimate(mapped));
+    ASSERT_TRUE(selectAccelerated(stmt, {saxpy}, model).mappings.empty());
+}
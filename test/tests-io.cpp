@@ -1,6 +1,14 @@
 #include "test.h"
 
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
 #include "taco/tensor.h"
+#include "taco/storage/file_io_bin.h"
+#include "taco/storage/file_io_mtx.h"
+#include "taco/storage/file_io_tns.h"
+#include "taco/util/env.h"
 
 using namespace taco;
 
@@ -127,3 +135,122 @@ TEST(io, mtxsymmetric) {
 
   ASSERT_TRUE(equals(expected, tensor));
 }
+
+TEST(io, parallelread) {
+  // Large enough to be parsed in several chunks
+  const int numLines = 200000;
+  const std::vector<std::string> values = {"1", "-2.5", "0.1", "3e-5",
+                                           "1.7976931348623157e308",
+                                           "123456789012345678901", "inf"};
+  std::stringstream tns;
+  std::stringstream mtx;
+  mtx << "%%MatrixMarket matrix coordinate real general\n"
+      << "% comment\n"
+      << "1000 600 " << numLines << "\n";
+  TensorBase expected(Float64, {1000,600});
+  unsigned seed = 1;
+  for (int n = 0; n < numLines; n++) {
+    seed = seed * 1103515245 + 12345;
+    int i = (seed >> 8) % 1000;
+    seed = seed * 1103515245 + 12345;
+    int j = (seed >> 8) % 600;
+    const std::string& value = values[n % values.size()];
+    tns << i+1 << " " << j+1 << " " << value << "\n";
+    mtx << i+1 << "\t" << j+1 << "  " << value << "\r\n";
+    expected.insert({i,j}, strtod(value.c_str(), nullptr));
+    if (n == numLines / 2) {
+      tns << "\n# comment\n";
+    }
+  }
+  // Make sure the inferred dimensions match
+  tns << "1000 600 0\n";
+  expected.insert({999,599}, 0.0);
+  expected.pack();
+
+  std::string filename = util::getTmpdir() + "io_parallelread.tns";
+  std::ofstream file(filename);
+  file << tns.str();
+  file.close();
+  TensorBase fromFile = readTNS(filename, CSR);
+  ASSERT_EQ(expected.getDimensions(), fromFile.getDimensions());
+  ASSERT_TRUE(equals(expected, fromFile));
+
+  TensorBase fromStream = readMTX(mtx, CSR);
+  ASSERT_TRUE(equals(expected, fromStream));
+
+  std::stringstream truncated("%%MatrixMarket matrix coordinate real general\n"
+                              "3 3 2\n1 1 1.0\n");
+  ASSERT_THROW(readMTX(truncated, CSR), TacoException);
+  std::stringstream malformed("1 1 1.0\n1 x 2.0\n");
+  ASSERT_THROW(readTNS(malformed, CSR), TacoException);
+}
+
+TEST(io, parallelwrite) {
+  // Large enough to be formatted in several shards
+  Tensor<double> tensor({300,400}, CSR);
+  Tensor<int8_t> chars({300,400}, CSR);
+  for (int i = 0; i < 300; i++) {
+    for (int j = (i % 2); j < 400; j += 2) {
+      tensor.insert({i,j}, (i - j) / 8.0);
+      chars.insert({i,j}, (int8_t)(i - j));
+    }
+  }
+  tensor.pack();
+  chars.pack();
+
+  std::stringstream expected;
+  std::stringstream expectedChars;
+  for (auto& value : iterate<double>(tensor)) {
+    expected << value.first[0]+1 << " " << value.first[1]+1 << " "
+             << value.second << std::endl;
+  }
+  for (auto& value : iterate<int8_t>(chars)) {
+    expectedChars << value.first[0]+1 << " " << value.first[1]+1 << " "
+                  << static_cast<int>(value.second) << std::endl;
+  }
+
+  std::stringstream tns;
+  writeTNS(tns, tensor);
+  ASSERT_EQ(expected.str(), tns.str());
+  std::stringstream tnsChars;
+  writeTNS(tnsChars, chars);
+  ASSERT_EQ(expectedChars.str(), tnsChars.str());
+
+  std::stringstream mtx;
+  writeMTX(mtx, tensor);
+  ASSERT_TRUE(equals(tensor, readMTX(mtx, CSR)));
+
+  std::stringstream binary;
+  writeBinary(binary, tensor.getStorage());
+  ASSERT_TRUE(equals(tensor, readBinary(binary, CSR)));
+}
+
+TEST(io, tbin) {
+  TensorBase tensor = read(testDataDirectory()+"2tensor.mtx", CSR);
+  std::string filename = util::getTmpdir() + "io_tbin.tbin";
+  write(filename, tensor);
+
+  TensorBase mapped = read(filename, CSR);
+  ASSERT_EQ(CSR, mapped.getFormat());
+  ASSERT_TRUE(equals(tensor, mapped));
+
+  // The arrays of a mapped tensor are copy on write.
+  Array values = mapped.getStorage().getValues();
+  ((double*)values.getData())[0] = 42.0;
+  ASSERT_FALSE(equals(tensor, mapped));
+  ASSERT_TRUE(equals(tensor, read(filename, CSR)));
+
+  ASSERT_THROW(read(filename, CSC), TacoException);
+}
+
+TEST(io, tbinstream) {
+  TensorBase tensor = read(testDataDirectory()+"d567.ttx", {Dense, Sparse, Dense});
+  std::stringstream stream;
+  writeBinary(stream, tensor);
+  TensorBase copy = readBinary(stream, {Dense, Sparse, Dense});
+  ASSERT_EQ(tensor.getDimensions(), copy.getDimensions());
+  ASSERT_TRUE(equals(tensor, copy));
+
+  std::stringstream truncated(stream.str().substr(0, 100));
+  ASSERT_THROW(readBinary(truncated, {Dense, Sparse, Dense}), TacoException);
+}
@@ -1853,4 +1853,93 @@ TEST_STMT(XorTestOrder2,
           }
 )
 
+TEST(lower, compileBatch) {
+  // Test names the gtest fixture base class within a TEST body.
+  typedef taco::test::Test Test;
+  vector<Test> tests = {
+    Test(alpha = beta + delta,
+         {TestCase({{beta,  {{{},  2.0}}},
+                    {delta, {{{},  30.0}}}},
+                   {{alpha, {{{},  32.0}}}})}),
+    Test(forall(i, a(i) = b(i) * c(i)),
+         {TestCase({{b, {{{0},  1.0}, {{1},   2.0}, {{3},  3.0}}},
+                    {c, {{{0}, 10.0}, {{2},  20.0}, {{3}, 30.0}}}},
+                   {{a, {{{0}, 10.0}, {{3},  90.0}}}})}),
+    Test(forall(i, a(i) = b(i) + c(i)),
+         {TestCase({{b, {{{0},  1.0}, {{1},   2.0}, {{3},  3.0}}},
+                    {c, {{{0}, 10.0}, {{2},  20.0}, {{3}, 30.0}}}},
+                   {{a, {{{0}, 11.0}, {{1},   2.0}, {{2}, 20.0},
+                         {{3}, 33.0}}}})})
+  };
+  map<TensorVar,Format> formats = {{b, sparse}};
+
+  vector<IndexStmt> stmts;
+  vector<map<TensorVar,TensorVar>> varsFormatted;
+  for (auto& test : tests) {
+    varsFormatted.push_back(formatVars(getTensorVars(test.stmt), formats));
+    stmts.push_back(replace(test.stmt, varsFormatted.back()));
+  }
+
+  vector<Kernel> kernels = compile(stmts);
+  ASSERT_EQ(tests.size(), kernels.size());
+
+  for (size_t k = 0; k < tests.size(); k++) {
+    SCOPED_TRACE(tests[k].stmt);
+    ASSERT_NE(nullptr, kernels[k].getComputeFunction());
+    const TestCase& testCase = tests[k].testCases[0];
+    vector<TensorVar> results = getResults(tests[k].stmt);
+
+    vector<TensorStorage> arguments;
+    for (auto& result : results) {
+      Format format = varsFormatted[k].at(result).getFormat();
+      arguments.push_back(testCase.getResult(result, format));
+    }
+    for (auto& argument : getArguments(tests[k].stmt)) {
+      Format format = varsFormatted[k].at(argument).getFormat();
+      arguments.push_back(testCase.getArgument(argument, format));
+    }
+
+    map<TensorVar, TensorStorage> expected;
+    for (auto& result : results) {
+      Format format = varsFormatted[k].at(result).getFormat();
+      expected.insert({result, testCase.getExpected(result, format)});
+    }
+
+    ASSERT_TRUE(kernels[k].assemble(arguments));
+    ASSERT_TRUE(kernels[k].compute(arguments));
+    verifyResults(results, arguments, varsFormatted[k], expected);
+  }
+}
+
+TEST(lower, compileTiered) {
+  map<TensorVar,TensorVar> varsFormatted =
+      formatVars({a, b, c}, {{b, sparse}});
+  IndexStmt stmt = replace(forall(i, a(i) = b(i) + c(i)), varsFormatted);
+  TestCase testCase({{b, {{{0},  1.0}, {{1},   2.0}, {{3},  3.0}}},
+                     {c, {{{0}, 10.0}, {{2},  20.0}, {{3}, 30.0}}}},
+                    {{a, {{{0}, 11.0}, {{1},   2.0}, {{2}, 20.0},
+                          {{3}, 33.0}}}});
+
+  Target target = getTargetFromEnvironment();
+  target.compileTier = Target::Tiered;
+  shared_ptr<ir::Module> module = make_shared<ir::Module>(target);
+  module->addFunction(taco::lower(stmt, "evaluate", true, true));
+  module->compile();
+  Kernel kernel(stmt, module, module->getFuncPtr("evaluate"), nullptr, nullptr);
+
+  // The kernel must give the same result before and after the optimized
+  // library replaces the unoptimized one
+  for (int run = 0; run < 2; run++) {
+    vector<TensorStorage> arguments = {
+      testCase.getResult(a, varsFormatted.at(a).getFormat()),
+      testCase.getArgument(b, varsFormatted.at(b).getFormat()),
+      testCase.getArgument(c, varsFormatted.at(c).getFormat())
+    };
+    ASSERT_TRUE(kernel(arguments));
+    verifyResults({a}, arguments, varsFormatted,
+                  {{a, testCase.getExpected(a, varsFormatted.at(a).getFormat())}});
+    module->waitForOptimization();
+  }
+}
+
 }}
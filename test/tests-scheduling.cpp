@@ -1134,4 +1134,91 @@ TEST(scheduling, mergeby_gallop_error) {
 
   IndexStmt stmt = y.getAssignment().concretize();
   ASSERT_THROW(stmt.mergeby(i, MergeStrategy::Gallop), taco::TacoException);
-}
\ No newline at end of file
+}
+TEST(scheduling, mergeby_simd_block) {
+  auto dim = 512;
+  Tensor<double> x("x", {dim}, Format({Sparse}));
+  Tensor<double> z("z", {dim}, Format({Sparse}));
+  for (int i = 0; i < dim; i += 2) {
+    x.insert({i}, (double)i);
+  }
+  for (int i = 0; i < dim; i += 3) {
+    z.insert({i}, (double)(i + 1));
+  }
+  x.pack(); z.pack();
+  IndexVar i("i");
+
+  Tensor<double> expected("expected", {dim}, Format({Dense}));
+  expected(i) = x(i) * z(i);
+  expected.evaluate();
+
+  // Dense and sparse results
+  for (const Format& format : {Format({Dense}), Format({Sparse})}) {
+    Tensor<double> y("y", {dim}, format);
+    y(i) = x(i) * z(i);
+    IndexStmt stmt = y.getAssignment().concretize();
+    y.compile(stmt.mergeby(i, MergeStrategy::SIMDBlock));
+    y.assemble();
+    y.compute();
+    ASSERT_TENSOR_EQ(expected, y);
+  }
+}
+
+TEST(scheduling, mergeby_merge_path) {
+  auto dim = 1000;
+  Tensor<double> x("x", {dim}, Format({Sparse}));
+  Tensor<double> z("z", {dim}, Format({Sparse}));
+  Tensor<double> xDense("xDense", {dim}, Format({Dense}));
+  Tensor<double> zDense("zDense", {dim}, Format({Dense}));
+  srand(4313);
+  for (int i = 0; i < dim; i++) {
+    if (rand() % 4 == 0) {
+      x.insert({i}, (double)(i + 1));
+      xDense.insert({i}, (double)(i + 1));
+    }
+    if (i > dim / 2 && rand() % 2 == 0) {
+      z.insert({i}, (double)(2 * i));
+      zDense.insert({i}, (double)(2 * i));
+    }
+  }
+  x.pack(); z.pack(); xDense.pack(); zDense.pack();
+  IndexVar i("i");
+
+  Tensor<double> expected("expected", {dim}, Format({Dense}));
+  expected(i) = xDense(i) + zDense(i);
+  expected.evaluate();
+  Tensor<double> y("y", {dim}, Format({Dense}));
+  y(i) = x(i) + z(i);
+  IndexStmt stmt = y.getAssignment().concretize();
+  y.compile(stmt.mergeby(i, MergeStrategy::MergePath));
+  y.assemble();
+  y.compute();
+  ASSERT_TENSOR_EQ(expected, y);
+
+  expected(i) = xDense(i) * zDense(i);
+  expected.evaluate();
+  y(i) = x(i) * z(i);
+  stmt = y.getAssignment().concretize();
+  y.compile(stmt.mergeby(i, MergeStrategy::MergePath));
+  y.assemble();
+  y.compute();
+  ASSERT_TENSOR_EQ(expected, y);
+}
+
+TEST(scheduling, mergeby_merge_path_error) {
+  Tensor<double> x("x", {8}, Format({Sparse}));
+  Tensor<double> z("z", {8}, Format({Sparse}));
+  Tensor<double> y("y", {8}, Format({Sparse}));
+  Tensor<double> a("a");
+  IndexVar i("i");
+
+  // Partitions cannot append to the same result
+  y(i) = x(i) + z(i);
+  IndexStmt stmt = y.getAssignment().concretize();
+  ASSERT_THROW(stmt.mergeby(i, MergeStrategy::MergePath), taco::TacoException);
+
+  // Nor reduce into the same component
+  a = x(i) * z(i);
+  stmt = a.getAssignment().concretize();
+  ASSERT_THROW(stmt.mergeby(i, MergeStrategy::MergePath), taco::TacoException);
+}
@@ -7,6 +7,7 @@
 #include <string>
 #include <vector>
 #include "taco/util/collections.h"
+#include "taco/util/parallel.h"
 
 using namespace taco;
 
@@ -78,6 +79,139 @@ TEST(tensor, duplicates) {
   }
 }
 
+TEST(tensor, pack_unsorted) {
+  // Enough components for the sort to split them over several threads
+  Tensor<double> a({300,700}, CSC);
+  map<vector<int>,double> vals;
+  unsigned seed = 7;
+  for (int n = 0; n < 200000; n++) {
+    seed = seed * 1103515245 + 12345;
+    int i = (seed >> 8) % 300;
+    seed = seed * 1103515245 + 12345;
+    int j = (seed >> 8) % 700;
+    a.insert({i,j}, (double)(n % 5));
+    vals[{i,j}] += n % 5;
+  }
+  a.pack();
+
+  size_t numVals = 0;
+  int previousColumn = 0;
+  int previousRow = -1;
+  for (auto val = a.beginTyped<int>(); val != a.endTyped<int>(); ++val) {
+    vector<int> coord = val->first.toVector();
+    ASSERT_TRUE(util::contains(vals, coord));
+    ASSERT_EQ(vals.at(coord), val->second);
+    ASSERT_TRUE(coord[1] > previousColumn ||
+                (coord[1] == previousColumn && coord[0] > previousRow));
+    previousColumn = coord[1];
+    previousRow = coord[0];
+    numVals++;
+  }
+  ASSERT_EQ(vals.size(), numVals);
+}
+
+TEST(tensor, pack_sorted) {
+  Tensor<double> a({4,5,6}, {Sparse, Dense, Sparse});
+  Tensor<double> expected({4,5,6}, {Sparse, Dense, Sparse});
+  for (int i = 0; i < 4; i++) {
+    for (int k = 0; k < 6; k += 2) {
+      a.insert({i,1,k}, (double)(i + k));
+    }
+  }
+  for (int k = 4; k >= 0; k -= 2) {
+    for (int i = 3; i >= 0; i--) {
+      expected.insert({i,1,k}, (double)(i + k));
+    }
+  }
+  a.pack();
+  expected.pack();
+  ASSERT_TRUE(equals(expected, a));
+}
+
+TEST(tensor, index_type64) {
+  Format csr64 = CSR;
+  csr64.setIndexType(Int64);
+  ASSERT_NE(CSR, csr64);
+
+  Tensor<double> a({30,40}, csr64);
+  Tensor<double> b({30,40}, csr64);
+  Tensor<double> a32({30,40}, CSR);
+  Tensor<double> b32({30,40}, CSR);
+  Tensor<double> x({40}, Format({Dense}));
+  for (int i = 0; i < 30; i++) {
+    for (int j = (i % 3); j < 40; j += 3) {
+      a.insert({i,j}, (double)(i + j));
+      a32.insert({i,j}, (double)(i + j));
+    }
+    b.insert({i,(i * 7) % 40}, 1.0);
+    b32.insert({i,(i * 7) % 40}, 1.0);
+  }
+  for (int j = 0; j < 40; j++) {
+    x.insert({j}, (double)j);
+  }
+  a.pack();
+  b.pack();
+  a32.pack();
+  b32.pack();
+  x.pack();
+
+  const ModeIndex& modeIndex = a.getStorage().getIndex().getModeIndex(1);
+  ASSERT_EQ(Int64, modeIndex.getIndexArray(0).getType());
+  ASSERT_EQ(Int64, modeIndex.getIndexArray(1).getType());
+  ASSERT_TRUE(equals(a32, a));
+
+  IndexVar i, j;
+  Tensor<double> y({30}, Format({Dense}));
+  Tensor<double> y32({30}, Format({Dense}));
+  y(i) = a(i,j) * x(j);
+  y32(i) = a32(i,j) * x(j);
+  y.evaluate();
+  y32.evaluate();
+  ASSERT_TRUE(equals(y32, y));
+
+  Tensor<double> c({30,40}, csr64);
+  Tensor<double> c32({30,40}, CSR);
+  c(i,j) = a(i,j) + b(i,j);
+  c32(i,j) = a32(i,j) + b32(i,j);
+  c.evaluate();
+  c32.evaluate();
+  ASSERT_EQ(Int64, c.getStorage().getIndex().getModeIndex(1)
+                    .getIndexArray(1).getType());
+  ASSERT_TRUE(equals(c32, c));
+}
+
+TEST(tensor, concurrent_pack) {
+  const vector<Format> formats = {CSR, CSC, DCSR, Format({Dense, Dense})};
+  const size_t numTensors = 256;
+  vector<Tensor<double>> tensors(numTensors);
+  vector<map<vector<int>,double>> vals(numTensors);
+  util::parallelFor(numTensors, [&](size_t t) {
+    Tensor<double> tensor({40,50}, formats[t % formats.size()]);
+    unsigned seed = t;
+    for (int n = 0; n < 500; n++) {
+      seed = seed * 1103515245 + 12345;
+      int i = (seed >> 8) % 40;
+      seed = seed * 1103515245 + 12345;
+      int j = (seed >> 8) % 50;
+      tensor.insert({i,j}, (double)t);
+      vals[t][{i,j}] += t;
+    }
+    tensor.pack();
+    tensors[t] = tensor;
+  }, 16);
+
+  for (size_t t = 0; t < numTensors; t++) {
+    size_t numVals = 0;
+    for (auto& val : tensors[t]) {
+      if (val.second != 0.0) {
+        ASSERT_EQ(vals[t].at(val.first.toVector()), val.second);
+        numVals++;
+      }
+    }
+    ASSERT_EQ(t == 0 ? 0 : vals[t].size(), numVals);
+  }
+}
+
 TEST(tensor, duplicates_scalar) {
   Tensor<double> a;
   a.insert({}, 1.0);
@@ -336,6 +470,37 @@ TEST(tensor, explicit_compiler_methods) {
   }
 }
 
+TEST(tensor, compile_async) {
+  Format  sv({Sparse});
+
+  Tensor<double> a({4}, sv);
+  Tensor<double> b({4}, sv);
+  Tensor<double> c({4}, sv);
+
+  b(0) = 1.0;
+  b(2) = 2.0;
+  c(2) = 3.0;
+
+  IndexVar i;
+  a(i) = b(i) + c(i);
+  auto compiled = a.compileAsync();
+
+  // Pack the operands while the kernel compiles.
+  b.pack();
+  c.pack();
+
+  compiled.wait();
+  ASSERT_FALSE(a.needsCompile());
+  a.assemble();
+  a.compute();
+
+  map<vector<int>,double> vals = {{{0}, 1.0}, {{2}, 5.0}};
+  for (auto val = a.beginTyped<int>(); val != a.endTyped<int>(); ++val) {
+    ASSERT_TRUE(util::contains(vals, val->first.toVector()));
+    ASSERT_EQ(vals.at(val->first.toVector()), val->second);
+  }
+}
+
 TEST(tensor, computation_dependency_modification) {
   Format csr({Dense,Sparse});
   Format csf({Sparse,Sparse,Sparse});
@@ -508,6 +508,10 @@ static bool setSchedulingCommands(vector<vector<string>> scheduleCommands, parse
         strategy = MergeStrategy::TwoFinger;
       } else if (strat == "Gallop") {
         strategy = MergeStrategy::Gallop;
+      } else if (strat == "SIMDBlock") {
+        strategy = MergeStrategy::SIMDBlock;
+      } else if (strat == "MergePath") {
+        strategy = MergeStrategy::MergePath;
       } else {
         taco_uerror << "Merge strategy not defined.";
         goto end;